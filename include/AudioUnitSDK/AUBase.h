@@ -10,13 +10,19 @@
 // clang-format off
 #include <AudioUnitSDK/AUConfig.h> // must come first
 // clang-format on
+#include <AudioUnitSDK/AUBinaryState.h>
 #include <AudioUnitSDK/AUBuffer.h>
+#include <AudioUnitSDK/AUEpoch.h>
 #include <AudioUnitSDK/AUInputElement.h>
 #include <AudioUnitSDK/AUOutputElement.h>
 #include <AudioUnitSDK/AUPlugInDispatch.h>
+#include <AudioUnitSDK/AUPresetBank.h>
+#include <AudioUnitSDK/AUPropertyChangeQueue.h>
+#include <AudioUnitSDK/AUPropertyRegistry.h>
 #include <AudioUnitSDK/AUScopeElement.h>
 #include <AudioUnitSDK/AUThreadSafeList.h>
 #include <AudioUnitSDK/AUUtility.h>
+#include <AudioUnitSDK/AUWorkerPool.h>
 #include <AudioUnitSDK/ComponentBase.h>
 
 // OS
@@ -34,15 +40,113 @@
 // std
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 // ________________________________________________________________________
 
 namespace ausdk {
 
+/// Custom properties handled by AUBase's property dispatch, numbered from the range reserved for
+/// custom properties. Property data containing pointers is only valid for in-process hosting.
+enum : AudioUnitPropertyID {
+	/// Write-only, any scope/element. An array of AUParameterIDValue which is applied to the
+	/// addressed element as one transaction (see AUBase::SetParameters).
+	kAUSDKProperty_ParameterTransaction = 'AUpt',
+
+	/// Write-only, global scope. An array of AUParameterAddressValue (see
+	/// AUBase::SetParameterValues).
+	kAUSDKProperty_SetParameterValues = 'AUps',
+
+	/// Read-only, global scope. An AUParameterValueList, passed in by the caller, whose entries'
+	/// values are filled in (see AUBase::GetParameterValues).
+	kAUSDKProperty_GetParameterValues = 'AUpg',
+
+	/// Read/write, global scope. A CFDataRef holding the unit's state in the AUBinaryState format
+	/// (see AUBase::SaveBinaryState); as with ClassInfo, the client releases the data it gets.
+	kAUSDKProperty_BinaryState = 'AUbs',
+
+	/// Read/write, global scope. As kAUSDKProperty_BinaryState, but getting it returns a delta
+	/// state (see AUBase::SaveDeltaState). Either property restores either kind of state.
+	kAUSDKProperty_DeltaState = 'AUds',
+
+	/// Read-only, input or output scope, once enabled by AUIOElement::SetMeteringEnabled. An
+	/// array of AUChannelMeterValues, one per channel of the element; reading restarts the peaks.
+	kAUSDKProperty_Meters = 'AUmt'
+};
+
+/// A fully addressed parameter value, as transferred by the batched parameter properties.
+struct AUParameterAddressValue {
+	AudioUnitScope mScope;
+	AudioUnitElement mElement;
+	AudioUnitParameterID mParameterID;
+	AudioUnitParameterValue mValue;
+};
+
+/// Property data for kAUSDKProperty_GetParameterValues.
+struct AUParameterValueList {
+	AUParameterAddressValue* mValues;
+	UInt32 mNumberValues;
+};
+
+/// Parameter values for several elements, collected off the render thread so that they can be
+/// applied as a whole at the start of a render cycle (see AUBase::PublishParameterSnapshot), or
+/// morphed to (see AUBase::BeginParameterMorph).
+class AUParameterSnapshot {
+public:
+	/// Adds values for `element`, which must outlive the snapshot, and whose parameters must not
+	/// be redefined while it is pending. Later values for an ID win; undefined IDs are ignored.
+	void Add(AUElement& element, std::span<const AUParameterIDValue> values);
+
+	/// Sets the values, as one transaction per element. Does not allocate.
+	void Apply() const noexcept;
+
+	[[nodiscard]] bool IsEmpty() const noexcept { return mRuns.empty(); }
+
+private:
+	friend class AUBase;
+
+	struct Run {
+		AUElement* element;
+		size_t begin;
+		size_t end;
+	};
+
+	// Render thread: applies the runs not applied yet, without waiting for other writers.
+	// Returns false, leaving the rest for a later call, if an element was mid-transaction.
+	bool TryApply() noexcept;
+
+	// Allocates the buffers for Morph().
+	void PrepareMorph();
+	// Sets the values at `position` between those found on the first call and the snapshot's.
+	// Render thread: returns false if an element was mid-transaction and was skipped.
+	bool Morph(AudioUnitParameterValue position);
+
+	std::vector<Run> mRuns;
+	std::vector<AUParameterIDValue> mValues;
+	std::vector<size_t> mIndices; // parallel to mValues: their storage positions
+	std::vector<AudioUnitParameterValue> mTarget; // and their values, densely
+	AUParameterSnapshot* mNextRetired{ nullptr };
+	size_t mAppliedRuns{ 0 }; // by TryApply
+
+	// Morph state, also parallel to mValues; see AUBase::BeginParameterMorph.
+	bool mIsMorph{ false };
+	bool mMorphStarted{ false };
+	UInt32 mMorphFrames{ 0 };
+	UInt32 mMorphElapsedFrames{ 0 };
+	std::vector<AudioUnitParameterValue> mSource;
+	std::vector<AudioUnitParameterValue> mCurrent;
+};
+
 /*!
 	@class	AUBase
 	@brief	Abstract base class for an Audio Unit implementation.
@@ -116,12 +220,19 @@ public:
 	OSStatus DispatchRemovePropertyValue(
 		AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement);
 
+	/// The defaults of GetPropertyInfo, GetProperty and SetProperty, which are called for the
+	/// properties AUBase does not implement itself, look them up in GetPropertyRegistry().
 	virtual OSStatus GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
 		AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable);
 	virtual OSStatus GetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
 		AudioUnitElement inElement, void* outData);
 	virtual OSStatus SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
 		AudioUnitElement inElement, const void* inData, UInt32 inDataSize);
+
+	/// The handlers for the properties of the class, usually a function-local static built from
+	/// the base class's registry. The default is empty.
+	[[nodiscard]] virtual const AUPropertyRegistry& GetPropertyRegistry() const;
+
 	virtual OSStatus RemovePropertyValue(
 		AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement);
 
@@ -138,6 +249,26 @@ public:
 	virtual OSStatus SetParameter(AudioUnitParameterID inID, AudioUnitScope inScope,
 		AudioUnitElement inElement, AudioUnitParameterValue inValue, UInt32 inBufferOffsetInFrames);
 
+	/// Sets several parameters of one element so that the render thread sees all of the new
+	/// values or none of them (see AUElement::SetParameters). This does not go through
+	/// SetParameter(); a subclass whose SetParameter() has side effects should override this too.
+	virtual OSStatus SetParameters(AudioUnitScope inScope, AudioUnitElement inElement,
+		std::span<const AUParameterIDValue> inValues);
+
+	/// Gets several parameters of one element. The default calls GetParameter() for each, so
+	/// that a subclass which computes or redirects values answers batched reads as it does
+	/// single ones; AUBase's own GetParameter() then uses the element looked up once here.
+	virtual OSStatus GetParameters(AudioUnitScope inScope, AudioUnitElement inElement,
+		std::span<AUParameterIDValue> ioValues);
+
+	/// Batched access to parameters of any scope and element. Each run of entries addressing
+	/// the same scope and element is one GetParameters() call or one SetParameters()
+	/// transaction. Setting therefore does NOT call SetParameter(): a subclass whose
+	/// SetParameter() has side effects must override SetParameters() as well. Processing stops at
+	/// the first error, leaving earlier runs applied.
+	virtual OSStatus GetParameterValues(std::span<AUParameterAddressValue> ioValues);
+	virtual OSStatus SetParameterValues(std::span<const AUParameterAddressValue> inValues);
+
 	[[nodiscard]] virtual bool CanScheduleParameters() const = 0;
 	virtual OSStatus ScheduleParameter(
 		const AudioUnitParameterEvent* inParameterEvent, UInt32 inNumEvents);
@@ -227,12 +358,38 @@ public:
 	virtual OSStatus SaveState(CFPropertyListRef* outData);
 	virtual void SaveExtendedScopes(CFMutableDataRef /*outData*/) {}
 	virtual OSStatus RestoreState(CFPropertyListRef plist);
+	/// The state saved by SaveState, including element names, in the compact AUBinaryState
+	/// format, written into a single preallocated CFData. The caller releases outData.
+	virtual OSStatus SaveBinaryState(CFDataRef* outData);
+	/// Like SaveBinaryState, but with only the parameters which changed since the previous delta
+	/// state was saved or restored or, for the first, which differ from their defaults. Each
+	/// delta has a new generation number and names the one it is based on, so that a host can
+	/// autosave a chain of small deltas and restore them in order.
+	virtual OSStatus SaveDeltaState(CFDataRef* outData);
+	/// Restores a state saved by SaveBinaryState or SaveDeltaState, with the same effects as
+	/// RestoreState. A delta is rejected unless it is based on the defaults or on the delta most
+	/// recently saved or restored.
+	virtual OSStatus RestoreBinaryState(CFDataRef data);
 	virtual OSStatus GetParameterValueStrings(
 		AudioUnitScope inScope, AudioUnitParameterID inParameterID, CFArrayRef* outStrings);
 	virtual OSStatus CopyClumpName(AudioUnitScope inScope, UInt32 inClumpID,
 		UInt32 inDesiredNameLength, CFStringRef* outClumpName);
+	/// The default returns the presets of the factory preset bank, if one is set.
 	virtual OSStatus GetPresets(CFArrayRef* outData) const;
 
+	/// Serves kAudioUnitProperty_FactoryPresets from `bank`, which may be shared by all instances:
+	/// the default GetPresets lists its presets, and the default NewFactoryPresetSet restores the
+	/// selected preset's state with RestoreBinaryState.
+	void SetFactoryPresetBank(std::shared_ptr<const AUPresetBank> bank) noexcept
+	{
+		mFactoryPresetBank = std::move(bank);
+	}
+
+	[[nodiscard]] const AUPresetBank* GetFactoryPresetBank() const noexcept
+	{
+		return mFactoryPresetBank.get();
+	}
+
 	/// Set the default preset for the unit. The number of the preset must be >= 0 and the name
 	/// should be valid, or the preset will be rejected.
 	bool SetAFactoryPresetAsCurrent(const AUPreset& inPreset);
@@ -365,6 +522,70 @@ public:
 		mUsesFixedBlockSize = inUsesFixedBlockSize;
 	}
 
+	/// When set, parameters restored while initialized (by RestoreState, RestoreBinaryState and
+	/// PublishParameterSnapshot) are applied by the render thread as a whole at the start of the
+	/// next render cycle, so that it never renders a partially restored state. Until then, other
+	/// threads still observe the previous values.
+	[[nodiscard]] bool DefersParameterRestore() const noexcept { return mDefersParameterRestore; }
+
+	void SetDefersParameterRestore(bool inFlag) noexcept { mDefersParameterRestore = inFlag; }
+
+	/// Applies the snapshot's values: immediately, or if DefersParameterRestore(), at the start of
+	/// the next render cycle. A snapshot published before that replaces this one. E.g. for a
+	/// NewFactoryPresetSet override which switches many parameters. The render thread never waits
+	/// for another thread's parameter transaction: if an element is mid-transaction, the rest of
+	/// the snapshot is applied on a later cycle. Not realtime-safe.
+	void PublishParameterSnapshot(std::unique_ptr<AUParameterSnapshot> snapshot);
+
+	/// Interpolates the parameters in `target` from their values at the start of the next render
+	/// cycle to the target's, on the render thread, with one pass over each element's values per
+	/// slice of ProcessForScheduledParams (which then also runs without scheduled events). For a
+	/// unit which does not call ProcessForScheduledParams, DoRender, DoProcess and
+	/// DoProcessMultiple instead advance the morph once per render cycle, before rendering, as if
+	/// the cycle were one slice; so do they on the cycle in which a unit first calls it. With a
+	/// duration, the morph position advances from 0 to 1 over that many frames, ending exactly on
+	/// the target's values. With a duration of 0, the position is the value of the parameter set
+	/// by SetParameterMorphPosition, which may be automated with ramps via ScheduleParameter. A
+	/// morph lasts until it completes or another snapshot or morph is published; when the unit is
+	/// not initialized, the target is applied immediately. Not realtime-safe.
+	void BeginParameterMorph(std::unique_ptr<AUParameterSnapshot> target, UInt32 durationInFrames);
+
+	/// Selects the global parameter, with values from 0 to 1, which positions morphs without a
+	/// duration.
+	void SetParameterMorphPosition(AudioUnitParameterID inParameterID) noexcept
+	{
+		mMorphPositionParameter = inParameterID;
+	}
+
+	/// Render thread: whether a morph is in progress.
+	[[nodiscard]] bool IsMorphingParameters() const noexcept { return mActiveMorph != nullptr; }
+
+	/// Invokes `f(scope, element, paramID, value)` for each parameter of the global, input, output
+	/// and group scopes which has changed since the previous call; see
+	/// AUElement::ConsumeParameterChangeFeed. A UI can poll this at its frame rate rather than
+	/// calling GetParameter for every parameter.
+	template <typename F>
+	void ConsumeParameterChangeFeed(F&& f)
+	{
+		for (AudioUnitScope scope = 0; scope < kNumScopes; ++scope) {
+			auto& unitScope = GetScope(scope);
+			for (UInt32 element = 0; element < unitScope.GetNumberOfElements(); ++element) {
+				if (auto* const el = unitScope.GetElement(element)) {
+					el->ConsumeParameterChangeFeed(
+						[&](AudioUnitParameterID paramID, AudioUnitParameterValue value) {
+							f(scope, element, paramID, value);
+						});
+				}
+			}
+		}
+	}
+
+	/// Non-null while a deferred restore collects parameters; see AUElement::RestoreParameters.
+	[[nodiscard]] AUParameterSnapshot* GetRestoringParameterSnapshot() const noexcept
+	{
+		return mRestoringParameters.get();
+	}
+
 	[[nodiscard]] virtual bool InRenderThread() const
 	{
 		return std::this_thread::get_id() == mRenderThreadID;
@@ -378,9 +599,87 @@ public:
 		return in != nullptr && in->IsActive();
 	}
 
+	/// Notifies the listeners to the property: immediately, or if DefersPropertyChanges(), via
+	/// a queue which coalesces repeated changes, making this realtime-safe.
 	virtual void PropertyChanged(
 		AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement);
 
+	[[nodiscard]] bool DefersPropertyChanges() const noexcept
+	{
+		return mDefersPropertyChanges.load(std::memory_order_acquire);
+	}
+
+	/// Defers notifications until DispatchPropertyChanges is called, e.g. so that changes made on
+	/// the render thread, such as MIDI hot-mapping, are delivered on another.
+	void SetDefersPropertyChanges(bool inFlag) noexcept
+	{
+		mDefersPropertyChanges.store(inFlag, std::memory_order_release);
+	}
+
+	/// Delivers the deferred notifications, returning their number. Not realtime-safe.
+	size_t DispatchPropertyChanges();
+
+	/// Defers notifications and delivers them every `interval` on a thread of the unit's own,
+	/// until StopPropertyChangeDispatcher or the unit is closed. Listeners are then called on
+	/// that thread.
+	void StartPropertyChangeDispatcher(std::chrono::milliseconds interval);
+
+	/// Stops the thread started by StartPropertyChangeDispatcher, delivering any remaining
+	/// notifications, and stops deferring them.
+	void StopPropertyChangeDispatcher();
+
+	/// The epochs of this unit's render cycles, for replacing resources which the render thread
+	/// uses (see AUEpochResource). Retired resources are deleted by calls to Reclaim, including
+	/// one when the unit is uninitialized, or by a reclaimer thread, which is stopped when the
+	/// unit is closed.
+	AUEpochDomain& GetRenderEpochDomain() noexcept { return mRenderEpochs; }
+
+	/// Opt-in parallel pulling for units with several independent inputs, such as mixers:
+	/// replaces the workers used by PullInputs with `threadCount` new ones, or with none if 0.
+	/// The workers are scheduled as real-time threads for the current maximum frames per slice
+	/// and input sample rate, so call this again if those change. May be called while
+	/// rendering; the previous workers are retired to the render epoch domain. Not
+	/// realtime-safe.
+	void SetParallelPullThreadCount(UInt32 threadCount);
+
+	[[nodiscard]] UInt32 GetParallelPullThreadCount() const noexcept
+	{
+		const AUWorkerPool* const workers = mPullWorkers.Get();
+		return workers != nullptr ? workers->ThreadCount() : 0;
+	}
+
+	/// Render thread: pulls each of the input elements numbered in `inElements` for the same
+	/// time stamp and frame count, concurrently on the parallel pull workers if there are any,
+	/// and otherwise one after another. The action flags of each pull, which begin as
+	/// `inActionFlags`, and its result are stored at the same index in `outActionFlags` and
+	/// `outResults`, which must be at least as long as `inElements`. Returns the first error,
+	/// or noErr. The inputs' upstream units and callbacks must tolerate being called
+	/// concurrently.
+	OSStatus PullInputs(std::span<const AudioUnitElement> inElements,
+		AudioUnitRenderActionFlags inActionFlags, const AudioTimeStamp& inTimeStamp,
+		UInt32 nFrames, std::span<AudioUnitRenderActionFlags> outActionFlags,
+		std::span<OSStatus> outResults);
+
+	/// A handler for a read-only global property (see GetPropertyRegistry) whose value is the
+	/// newest snapshot published by the render thread to `Member`, an AUTripleBuffer of a
+	/// trivially copyable type; e.g. `MakeSnapshotPropertyHandler<&MyUnit::mSpectrum>('spec')`.
+	template <auto Member>
+	static AUPropertyRegistry::Handler MakeSnapshotPropertyHandler(AudioUnitPropertyID inID)
+	{
+		using Unit = typename SnapshotMember<decltype(Member)>::Unit;
+		using Snapshot = typename SnapshotMember<decltype(Member)>::Snapshot;
+		static_assert(std::is_trivially_copyable_v<Snapshot>);
+		return { .id = inID,
+			.dataSize = sizeof(Snapshot),
+			.get = [](AUBase& unit, AudioUnitPropertyID, AudioUnitScope, AudioUnitElement,
+					   void* outData) -> OSStatus {
+				(static_cast<Unit&>(unit).*Member).Read([outData](const Snapshot& snapshot) {
+					std::memcpy(outData, &snapshot, sizeof(Snapshot));
+				});
+				return noErr;
+			} };
+	}
+
 	// These calls can be used to call a Host's Callbacks. The method returns -1 if the host
 	// hasn't supplied the callback. Any other result is returned by the host.
 	// As in the API contract, for a parameter's value, you specify a pointer
@@ -544,6 +843,7 @@ protected:
 	};
 	using PropertyListeners = std::vector<PropertyListener>;
 
+	/// In order of property ID. Not synchronized with a property change dispatcher thread.
 	[[nodiscard]] const PropertyListeners& GetPropertyListeners() const noexcept
 	{
 		return mPropertyListeners;
@@ -577,6 +877,50 @@ private:
 
 	bool HasIcon();
 
+	// GetParameterInfo, served from the elements' metadata caches when possible.
+	OSStatus GetCachedParameterInfo(AudioUnitScope inScope, AudioUnitParameterID inParameterID,
+		AudioUnitParameterInfo& outParameterInfo);
+	void InvalidateParameterMetadata();
+
+	OSStatus WriteBinaryState(CFDataRef* outData, bool delta);
+
+	// Collects the parameters restored during its lifetime into a snapshot, which it publishes
+	// on successful completion.
+	class ParameterRestoreScope;
+
+	void EnqueueParameterSnapshot(std::unique_ptr<AUParameterSnapshot> snapshot);
+
+	// Render thread: applies the published snapshot, if any, or makes it the active morph.
+	void ApplyPublishedParameters();
+	// Render thread: applies what it can of a snapshot without waiting, and retires it once it
+	// is complete; otherwise keeps it for the next cycle and returns false.
+	bool ApplyParameterSnapshot(AUParameterSnapshot* snapshot) noexcept;
+	// Render thread: applies the active morph at the start of a slice, then advances it.
+	void MorphParameters(UInt32 inFramesToProcess);
+	// Render thread, once per cycle: advances the active morph over the whole cycle, unless the
+	// unit slices it with ProcessForScheduledParams.
+	void AdvanceUnslicedMorph(UInt32 inFramesToProcess);
+	// Render thread: hands a snapshot back for deletion.
+	void RetireParameterSnapshot(AUParameterSnapshot* snapshot) noexcept;
+	// Non-realtime threads: deletes the snapshots handed back by the render thread.
+	void ReclaimParameterSnapshots() noexcept;
+
+	template <typename MemberPointer>
+	struct SnapshotMember;
+	template <typename UnitType, typename T>
+	struct SnapshotMember<AUTripleBuffer<T> UnitType::*> {
+		using Unit = UnitType;
+		using Snapshot = T;
+	};
+
+	// Calls the listeners to the property. Neither locks nor allocates, so it is safe on the
+	// render thread.
+	void NotifyPropertyListeners(
+		AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement) noexcept;
+	// With mPropertyListenersMutex held: publishes a copy of mPropertyListeners for
+	// NotifyPropertyListeners.
+	void PublishPropertyListeners();
+
 	[[nodiscard]] std::string CreateLoggingString() const;
 
 protected:
@@ -659,8 +1003,20 @@ private:
 			return this->mRenderNotify == other.mRenderNotify &&
 				   this->mRenderNotifyRefCon == other.mRenderNotifyRefCon;
 		}
+
+		struct Hash {
+			size_t operator()(const RenderCallback& callback) const noexcept
+			{
+				constexpr size_t kMultiplier = 31;
+				return (std::hash<AURenderCallback>{}(callback.mRenderNotify) * kMultiplier) ^
+					   std::hash<void*>{}(callback.mRenderNotifyRefCon);
+			}
+		};
 	};
 
+	// render notifications, including those added or removed since the last render
+	static constexpr size_t kRenderCallbackListCapacity = 128;
+
 protected:
 	static constexpr AudioUnitScope kNumScopes = 4;
 
@@ -680,7 +1036,8 @@ private:
 	const UInt32 mInitNumOutputEls;
 	const UInt32 mInitNumGroupEls;
 	std::array<AUScope, kNumScopes> mScopes;
-	AUThreadSafeList<RenderCallback> mRenderCallbacks;
+	AUBoundedThreadSafeList<RenderCallback, kRenderCallbackListCapacity, RenderCallback::Hash>
+		mRenderCallbacks;
 	bool mRenderCallbacksTouched{ false };
 	std::thread::id mRenderThreadID{};
 	bool mWantsRenderThreadID{ false };
@@ -694,10 +1051,31 @@ private:
 	uint64_t mLastTimeMessagePrinted{ 0 };
 #endif
 	AUPreset mCurrentPreset{ -1, nullptr };
+	std::shared_ptr<const AUPresetBank> mFactoryPresetBank;
+	UInt64 mStateGeneration{ 0 }; // of the delta state last saved or restored
 	bool mUsesFixedBlockSize{ false };
+	bool mDefersParameterRestore{ false };
+	std::unique_ptr<AUParameterSnapshot> mRestoringParameters;
+	std::atomic<AUParameterSnapshot*> mPublishedParameters{ nullptr };
+	std::atomic<AUParameterSnapshot*> mRetiredParameters{ nullptr }; // linked by mNextRetired
+	AUParameterSnapshot* mActiveMorph{ nullptr };                    // owned by the render thread
+	AUParameterSnapshot* mUnappliedSnapshot{ nullptr };              // likewise
+	bool mSlicesParameterMorph{ false };   // the unit has called ProcessForScheduledParams
+	bool mMorphAdvancedThisCycle{ false }; // by AdvanceUnslicedMorph
+	std::optional<AudioUnitParameterID> mMorphPositionParameter;
 
 	ParameterEventList mParamEventList;
-	PropertyListeners mPropertyListeners;
+	PropertyListeners mPropertyListeners; // guarded by mPropertyListenersMutex
+	std::mutex mPropertyListenersMutex;
+	// An immutable copy of mPropertyListeners, read without locking by the threads counted in
+	// mPropertyListenerReaders. Replaced copies are deleted once no thread is reading.
+	std::atomic<const PropertyListeners*> mPublishedPropertyListeners{ nullptr };
+	std::atomic<UInt32> mPropertyListenerReaders{ 0 };
+	std::vector<std::unique_ptr<const PropertyListeners>> mRetiredPropertyListeners; // likewise
+	std::atomic<bool> mDefersPropertyChanges{ false }; // read on the render thread
+	AUPropertyChangeQueue mPropertyChanges; // after the listeners, for its dispatcher thread
+	AUEpochDomain mRenderEpochs;
+	AUEpochResource<AUWorkerPool> mPullWorkers{ mRenderEpochs };
 	bool mBuffersAllocated{ false };
 	const std::string mLogString;
 	Owned<CFStringRef> mNickName;
@@ -0,0 +1,231 @@
+/*!
+	@file		AudioUnitSDK/AUBinaryState.h
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#ifndef AudioUnitSDK_AUBinaryState_h
+#define AudioUnitSDK_AUBinaryState_h
+
+// module
+// clang-format off
+#include <AudioUnitSDK/AUConfig.h> // must come first
+// clang-format on
+#include <AudioUnitSDK/AUUtility.h>
+
+// OS
+#include <AudioToolbox/AUComponent.h>
+#include <CoreFoundation/CFByteOrder.h>
+
+// std
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+namespace ausdk {
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUBinaryState
+	@brief	Layout of the compact binary state exchanged via kAUSDKProperty_BinaryState.
+
+	A cheaper alternative to the ClassInfo property list for frequent saves. It holds the same
+	parameter data, preset, render quality and element names. All fields are little-endian
+	32-bit words:
+
+		header:		magic, version, componentType, componentSubType, componentManufacturer,
+					flags, payload size in bytes, CRC-32 of the payload
+		payload:	preset name size, UTF-8 preset name padded to a word,
+					render quality (valid if kFlagRenderQuality),
+					size of the extended scopes' data, that data (as in ClassInfo) padded,
+					element name count, then for each: scope, element, UTF-8 name size,
+					that name padded (from version 2; version 1 states have no names),
+					if kFlagDelta: base generation and generation, as 64-bit low/high pairs,
+					then for each element with parameters:
+					scope, element, count, count * (parameter ID, Float32 value)
+
+	A delta state (see AUBase::SaveDeltaState) only has records for the parameters which differ
+	from its base: the state with the base generation, or the defaults if that is 0.
+*/
+struct AUBinaryState {
+	static constexpr UInt32 kMagic = 'AUbs';
+	static constexpr UInt32 kVersion = 2;
+	static constexpr UInt32 kOldestVersion = 1; // still restored
+	static constexpr UInt32 kFirstVersionWithElementNames = 2;
+	static constexpr UInt32 kFlagRenderQuality = 1u << 0u;
+	static constexpr UInt32 kFlagDelta = 1u << 1u;
+
+	static constexpr size_t kWordSize = sizeof(UInt32);
+	static constexpr size_t kHeaderSize = 8 * kWordSize;
+	static constexpr size_t kPayloadSizeOffset = 6 * kWordSize;
+	static constexpr size_t kChecksumOffset = 7 * kWordSize;
+	static constexpr size_t kParameterSize = 2 * kWordSize;
+
+	[[nodiscard]] static constexpr size_t PaddedSize(size_t size) noexcept
+	{
+		return (size + kWordSize - 1) & ~(kWordSize - 1);
+	}
+
+	/// CRC-32 (as used by zlib) of `bytes`, continuing from `crc`.
+	[[nodiscard]] static constexpr UInt32 Checksum(
+		std::span<const UInt8> bytes, UInt32 crc = 0) noexcept
+	{
+		crc = ~crc;
+		for (const UInt8 byte : bytes) {
+			crc = kCRCTable[(crc ^ byte) & 0xFFu] ^ (crc >> 8u); // NOLINT magic number
+		}
+		return ~crc;
+	}
+
+private:
+	static constexpr auto kCRCTable = [] {
+		std::array<UInt32, 256> table{}; // NOLINT magic number
+		for (UInt32 i = 0; i < table.size(); ++i) {
+			UInt32 crc = i;
+			for (int bit = 0; bit < 8; ++bit) { // NOLINT magic number
+				// NOLINTNEXTLINE magic number: reversed CRC-32 polynomial
+				crc = ((crc & 1u) != 0u) ? (crc >> 1u) ^ 0xEDB88320u : crc >> 1u;
+			}
+			table[i] = crc;
+		}
+		return table;
+	}();
+};
+
+// ____________________________________________________________________________
+//
+/// Writes AUBinaryState words into a buffer allocated up front by the caller, which must be large
+/// enough; it is never reallocated.
+class AUBinaryStateWriter {
+public:
+	explicit AUBinaryStateWriter(std::span<UInt8> buffer) noexcept : mBuffer{ buffer } {}
+
+	void WriteUInt32(UInt32 value)
+	{
+		const auto littleEndian = CFSwapInt32HostToLittle(value);
+		std::memcpy(Claim(sizeof(littleEndian)).data(), &littleEndian, sizeof(littleEndian));
+	}
+
+	void WriteFloat32(Float32 value) { WriteUInt32(std::bit_cast<UInt32>(value)); }
+
+	void WriteUInt64(UInt64 value)
+	{
+		WriteUInt32(static_cast<UInt32>(value));
+		WriteUInt32(static_cast<UInt32>(value >> 32u)); // NOLINT magic number
+	}
+
+	void WriteBytes(std::span<const UInt8> bytes)
+	{
+		if (!bytes.empty()) {
+			std::memcpy(Claim(bytes.size()).data(), bytes.data(), bytes.size());
+		}
+	}
+
+	/// Writes a size-prefixed block, padded to a word.
+	void WriteBlock(std::span<const UInt8> bytes)
+	{
+		WriteUInt32(static_cast<UInt32>(bytes.size()));
+		WriteBytes(bytes);
+		Pad();
+	}
+
+	/// Reserves `size` bytes at the current position, e.g. for a producer writing in place.
+	std::span<UInt8> Claim(size_t size)
+	{
+		ThrowExceptionIf(size > mBuffer.size() - mSize, kAudio_MemFullError);
+		const auto bytes = mBuffer.subspan(mSize, size);
+		mSize += size;
+		return bytes;
+	}
+
+	/// Zero-fills up to the next word boundary.
+	void Pad()
+	{
+		const auto padding = Claim(AUBinaryState::PaddedSize(mSize) - mSize);
+		std::ranges::fill(padding, UInt8{ 0 });
+	}
+
+	/// Overwrites a word already written, e.g. a size which is only known afterwards.
+	void WriteAt(size_t offset, UInt32 value)
+	{
+		ThrowExceptionIf(offset + sizeof(value) > mSize, kAudio_ParamError);
+		const auto littleEndian = CFSwapInt32HostToLittle(value);
+		std::memcpy(mBuffer.subspan(offset).data(), &littleEndian, sizeof(littleEndian));
+	}
+
+	/// Discards what was written after `size` bytes, e.g. a record which turned out to be empty.
+	void Truncate(size_t size) noexcept { mSize = std::min(size, mSize); }
+
+	[[nodiscard]] size_t Size() const noexcept { return mSize; }
+	[[nodiscard]] std::span<UInt8> Written() const noexcept { return mBuffer.first(mSize); }
+
+private:
+	std::span<UInt8> mBuffer;
+	size_t mSize{ 0 };
+};
+
+// ____________________________________________________________________________
+//
+/// Reads AUBinaryState words in place, without copying the data. Reading beyond the end throws
+/// kAudioUnitErr_InvalidPropertyValue.
+class AUBinaryStateReader {
+public:
+	explicit AUBinaryStateReader(std::span<const UInt8> data) noexcept : mData{ data } {}
+
+	UInt32 ReadUInt32()
+	{
+		UInt32 littleEndian = 0;
+		std::memcpy(&littleEndian, ReadBytes(sizeof(littleEndian)).data(), sizeof(littleEndian));
+		return CFSwapInt32LittleToHost(littleEndian);
+	}
+
+	Float32 ReadFloat32() { return std::bit_cast<Float32>(ReadUInt32()); }
+
+	/// Reads a big-endian word, as in the ClassInfo parameter data which the state embeds for
+	/// extended scopes.
+	UInt32 ReadBigUInt32()
+	{
+		UInt32 bigEndian = 0;
+		std::memcpy(&bigEndian, ReadBytes(sizeof(bigEndian)).data(), sizeof(bigEndian));
+		return CFSwapInt32BigToHost(bigEndian);
+	}
+
+	UInt64 ReadUInt64()
+	{
+		const UInt64 low = ReadUInt32();
+		return low | (UInt64{ ReadUInt32() } << 32u); // NOLINT magic number
+	}
+
+	/// Returns a view of the next `size` bytes of the data.
+	std::span<const UInt8> ReadBytes(size_t size)
+	{
+		ThrowExceptionIf(size > mData.size(), kAudioUnitErr_InvalidPropertyValue);
+		const auto bytes = mData.first(size);
+		mData = mData.subspan(size);
+		return bytes;
+	}
+
+	/// Reads a size-prefixed block, skipping its padding.
+	std::span<const UInt8> ReadBlock()
+	{
+		const auto size = ReadUInt32();
+		const auto block = ReadBytes(size);
+		ReadBytes(AUBinaryState::PaddedSize(size) - size);
+		return block;
+	}
+
+	[[nodiscard]] bool AtEnd() const noexcept { return mData.empty(); }
+	[[nodiscard]] size_t Remaining() const noexcept { return mData.size(); }
+
+	/// The bytes not read yet, e.g. for a parser which reports how many it consumed.
+	[[nodiscard]] std::span<const UInt8> Unread() const noexcept { return mData; }
+
+private:
+	std::span<const UInt8> mData;
+};
+
+} // namespace ausdk
+
+#endif // AudioUnitSDK_AUBinaryState_h
@@ -60,6 +60,37 @@ public:
 	virtual void Deallocate(AllocatedBuffer* allocatedBuffer);
 };
 
+/*!
+	@class	AUZeroBufferPool
+	@brief	A process-wide, read-only region of zeros at which silent buffers can be pointed
+			instead of being cleared.
+
+	The region is mapped without write access, so writing through one of its pointers faults;
+	a buffer that must be written has to be given memory of its own first.
+*/
+class AUZeroBufferPool {
+public:
+	/// Ensures that Get() can satisfy requests of up to `inBytes`. Not realtime-safe.
+	static void Reserve(UInt32 inBytes);
+
+	/// Returns at least `inBytes` of zeros, or nullptr if that much has not been reserved.
+	[[nodiscard]] static const void* Get(UInt32 inBytes) noexcept;
+
+	/// Whether `inData` points into the shared zeros.
+	[[nodiscard]] static bool Contains(const void* inData) noexcept;
+
+	/// Whether any buffer of `abl` points into the shared zeros.
+	[[nodiscard]] static bool Contains(const AudioBufferList& abl) noexcept
+	{
+		for (UInt32 i = 0; i < abl.mNumberBuffers; ++i) {
+			if (Contains(abl.mBuffers[i].mData)) { // NOLINT
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
 /*!
 	@class	AUBufferList
 	@brief	Manages an `AudioBufferList` backed by allocated memory buffers.
@@ -149,6 +180,11 @@ public:
 		}
 	}
 
+	/// Makes the current buffer list silent. Buffers in this list's own memory are pointed at the
+	/// AUZeroBufferPool instead of being cleared, if enough zeros have been reserved; other
+	/// buffers are cleared.
+	void Silence();
+
 	[[nodiscard]] UInt32 GetAllocatedFrames() const noexcept { return mAllocatedFrames; }
 
 private:
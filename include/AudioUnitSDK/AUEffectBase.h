@@ -37,12 +37,7 @@ public:
 	OSStatus Initialize() override;
 	void Cleanup() override;
 	OSStatus Reset(AudioUnitScope inScope, AudioUnitElement inElement) override;
-	OSStatus GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable) override;
-	OSStatus GetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, void* outData) override;
-	OSStatus SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, const void* inData, UInt32 inDataSize) override;
+	[[nodiscard]] const AUPropertyRegistry& GetPropertyRegistry() const override;
 	bool StreamFormatWritable(AudioUnitScope scope, AudioUnitElement element) override;
 	OSStatus ChangeStreamFormat(AudioUnitScope inScope, AudioUnitElement inElement,
 		const AudioStreamBasicDescription& inPrevFormat,
@@ -105,10 +100,30 @@ public:
 		mProcessesInPlace = inProcessesInPlace;
 	}
 
+	// When enabled, silent output rendered into the output element's own buffers (because the
+	// caller passed null buffers) points at the shared AUZeroBufferPool instead of being cleared.
+	// The zeros are read-only, so only enable this when whatever pulls from the unit does not
+	// write into the buffers it receives; units built on AUEffectBase never process in place
+	// on the shared zeros. Enabling it reserves zeros for the maximum frames per slice, as does
+	// each reallocation of the buffers while it is enabled; not realtime-safe.
+	[[nodiscard]] bool SharesSilentBuffers() const noexcept { return mSharesSilentBuffers; }
+	void SetSharesSilentBuffers(bool inSharesSilentBuffers);
+
+	// When enabled, a kernel that has reported silent output after the input has been silent for
+	// longer than the latency plus tail time is no longer called; its output is left silent until
+	// signal returns, or skipping is disabled, at which point the kernel's Resume() is called
+	// before it processes again.
+	[[nodiscard]] bool SkipsSilentKernels() const noexcept { return mSkipsSilentKernels; }
+	void SetSkipsSilentKernels(bool inSkipsSilentKernels) noexcept
+	{
+		mSkipsSilentKernels = inSkipsSilentKernels;
+	}
+
 	using KernelList = std::vector<std::unique_ptr<AUKernelBase>>;
 
 protected:
 	void MaintainKernels();
+	void ReallocateBuffers() override;
 
 	// This is used in the render call to see if an effect is bypassed
 	// It can return a different status than IsBypassEffect (though it MUST take that into account)
@@ -139,10 +154,14 @@ protected:
 #endif
 
 private:
+	void ReserveSilentBuffers();
+
 	KernelList mKernelList;
 	bool mBypassEffect{ false };
 	bool mParamSRDep{ false };
 	bool mProcessesInPlace;
+	bool mSkipsSilentKernels{ false };
+	bool mSharesSilentBuffers{ false };
 	AUSilentTimeout mSilentTimeout;
 	AUOutputElement* mMainOutput{ nullptr };
 	AUInputElement* mMainInput{ nullptr };
@@ -175,6 +194,10 @@ public:
 
 	virtual void Reset() {}
 
+	// Called before a kernel that was skipped for silence processes again. Override to warm up
+	// instead of clearing all state.
+	virtual void Resume() { Reset(); }
+
 	virtual void Process(const Float32* /*inSourceP*/, Float32* /*inDestP*/,
 		UInt32 /*inFramesToProcess*/, bool& /*ioSilence*/) = 0;
 
@@ -188,9 +211,17 @@ public:
 	void SetChannelNum(UInt32 inChan) noexcept { mChannelNum = inChan; }
 	[[nodiscard]] UInt32 GetChannelNum() const noexcept { return mChannelNum; }
 
+	// True while the kernel is being skipped by AUEffectBase::SkipsSilentKernels().
+	[[nodiscard]] bool IsIdle() const noexcept { return mIdle; }
+
 protected:
 	AUEffectBase& mAudioUnit; // NOLINT protected
 	UInt32 mChannelNum = 0;   // NOLINT protected
+
+private:
+	friend class AUEffectBase;
+
+	bool mIdle = false;
 };
 
 } // namespace ausdk
@@ -0,0 +1,193 @@
+/*!
+	@file		AudioUnitSDK/AUEpoch.h
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#ifndef AudioUnitSDK_AUEpoch_h
+#define AudioUnitSDK_AUEpoch_h
+
+// module
+// clang-format off
+#include <AudioUnitSDK/AUConfig.h> // must come first
+// clang-format on
+#include <AudioUnitSDK/AUUtility.h>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ausdk {
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUEpochDomain
+	@brief	Deferred deletion of objects which the render thread may still be using.
+
+	The render thread brackets each render cycle with EnterRender and ExitRender (AUBase does this
+	in DoRender, DoProcess and DoProcessMultiple), recording the epoch in which the cycle began.
+	A control thread which has replaced an object, e.g. an impulse response or a wavetable, hands
+	the old one to Retire, which advances the epoch. Reclaim deletes the retired objects which no
+	render cycle can still see: those retired while the render thread was idle, or before its
+	current cycle began. So the render thread neither locks nor frees, and a control thread never
+	waits for it.
+
+	Reclaim may be called on any non-realtime thread, or by a thread of the domain's own (see
+	StartReclaimer), so that large deallocations are also kept off the control threads. Render
+	cycles must not overlap, which the Audio Unit API guarantees; they may nest.
+*/
+class AUEpochDomain {
+public:
+	/// Render thread: marks a render cycle for the lifetime of the object.
+	class RenderScope {
+	public:
+		explicit RenderScope(AUEpochDomain& domain) noexcept : mDomain{ domain }
+		{
+			mDomain.EnterRender();
+		}
+		~RenderScope() noexcept { mDomain.ExitRender(); }
+
+		RenderScope(const RenderScope&) = delete;
+		RenderScope(RenderScope&&) = delete;
+		RenderScope& operator=(const RenderScope&) = delete;
+		RenderScope& operator=(RenderScope&&) = delete;
+
+	private:
+		AUEpochDomain& mDomain;
+	};
+
+	AUEpochDomain() = default;
+	/// Deletes all the retired objects; no render cycle may be in progress.
+	~AUEpochDomain();
+
+	AUEpochDomain(const AUEpochDomain&) = delete;
+	AUEpochDomain(AUEpochDomain&&) = delete;
+	AUEpochDomain& operator=(const AUEpochDomain&) = delete;
+	AUEpochDomain& operator=(AUEpochDomain&&) = delete;
+
+	/// Render thread. Realtime-safe.
+	void EnterRender() noexcept
+	{
+		if (mRenderDepth++ == 0) {
+			mRenderEpoch.store(mEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+		}
+	}
+
+	/// Render thread. Realtime-safe.
+	void ExitRender() noexcept
+	{
+		if (--mRenderDepth == 0) {
+			mRenderEpoch.store(kIdle, std::memory_order_release);
+		}
+	}
+
+	/// Takes ownership of an object which has already been made unreachable to render cycles
+	/// beginning from now on, deleting it once no earlier cycle is still in progress. Not
+	/// realtime-safe.
+	template <typename T>
+	void Retire(std::unique_ptr<T> object)
+	{
+		if (object) {
+			Retire(object.get(), [](void* retired) noexcept {
+				delete static_cast<T*>(retired); // NOLINT owning
+			});
+			static_cast<void>(object.release()); // now owned by the domain
+		}
+	}
+
+	/// Deletes the retired objects which no render cycle can still be using, returning their
+	/// number. Not realtime-safe.
+	size_t Reclaim();
+
+	/// The number of retired objects not yet deleted.
+	[[nodiscard]] size_t RetiredCount() const;
+
+	/// Calls Reclaim every `interval`, on a thread of its own, until StopReclaimer.
+	void StartReclaimer(std::chrono::milliseconds interval);
+
+	/// Stops the reclaimer thread, if running, after a final Reclaim.
+	void StopReclaimer();
+
+	[[nodiscard]] bool IsReclaiming() const noexcept { return mReclaimer.joinable(); }
+
+private:
+	static constexpr UInt64 kIdle = std::numeric_limits<UInt64>::max();
+
+	struct Retired {
+		UInt64 epoch;
+		void* object;
+		void (*destroy)(void*) noexcept;
+	};
+
+	void Retire(void* object, void (*destroy)(void*) noexcept);
+
+	// advanced by each Retire
+	[[maybe_unused]] AUCacheLinePadding mEpochPadding{};
+	std::atomic<UInt64> mEpoch{ 1 };
+	// written by the render thread: the epoch in which the current cycle began, or kIdle
+	[[maybe_unused]] AUCacheLinePadding mRenderEpochPadding{};
+	std::atomic<UInt64> mRenderEpoch{ kIdle };
+	UInt32 mRenderDepth{ 0 };
+
+	[[maybe_unused]] AUCacheLinePadding mRetiredPadding{};
+	mutable std::mutex mRetiredMutex;
+	std::vector<Retired> mRetired;
+
+	std::thread mReclaimer;
+	std::mutex mReclaimerMutex;
+	std::condition_variable mReclaimerWakeup;
+	bool mReclaimerStopping{ false };
+};
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUEpochResource
+	@brief	An object which control threads replace while the render thread uses it.
+
+	Publish installs a new version atomically and retires the previous one to the domain, which
+	deletes it once the render thread has finished with it. Get, on the render thread, returns
+	the current version, which stays valid until the end of the render cycle. The domain must
+	outlive the resource; e.g. a member of an AUBase subclass, with AUBase::GetRenderEpochDomain.
+*/
+template <typename T>
+class AUEpochResource {
+public:
+	explicit AUEpochResource(AUEpochDomain& domain, std::unique_ptr<T> initial = nullptr)
+		: mDomain{ domain }, mCurrent{ initial.release() }
+	{
+	}
+
+	/// Deletes the current version; no render cycle may be using it.
+	~AUEpochResource() { delete mCurrent.load(std::memory_order_acquire); } // NOLINT owning
+
+	AUEpochResource(const AUEpochResource&) = delete;
+	AUEpochResource(AUEpochResource&&) = delete;
+	AUEpochResource& operator=(const AUEpochResource&) = delete;
+	AUEpochResource& operator=(AUEpochResource&&) = delete;
+
+	/// Not realtime-safe.
+	void Publish(std::unique_ptr<T> resource)
+	{
+		mDomain.Retire(std::unique_ptr<T>{ mCurrent.exchange(
+			resource.release(), std::memory_order_seq_cst) });
+	}
+
+	/// Render thread, within a render cycle: the current version, or null. Sequentially
+	/// consistent so that it is ordered after the cycle's EnterRender.
+	[[nodiscard]] T* Get() const noexcept { return mCurrent.load(std::memory_order_seq_cst); }
+
+private:
+	AUEpochDomain& mDomain;
+	std::atomic<T*> mCurrent;
+};
+
+} // namespace ausdk
+
+#endif // AudioUnitSDK_AUEpoch_h
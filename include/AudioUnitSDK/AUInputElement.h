@@ -15,6 +15,8 @@
 #include <AudioToolbox/AUComponent.h>
 #include <AudioToolbox/AudioUnitProperties.h>
 
+#include <atomic>
+
 namespace ausdk {
 
 /*!
@@ -46,6 +48,39 @@ public:
 		const AudioTimeStamp& inTimeStamp, AudioUnitElement inElement, UInt32 nFrames,
 		AudioBufferList& inBufferList);
 
+	/// Opt-in detection of silence from the samples themselves, for upstream units and
+	/// callbacks that never set kAudioUnitRenderAction_OutputIsSilence: after each successful
+	/// pull whose samples all have a magnitude of at most `inThreshold`, the flag is set so
+	/// that silence propagates through AUEffectBase::IsInputSilent. Only 32-bit float formats
+	/// are scanned.
+	void SetDetectsSilence(bool inDetectsSilence, Float32 inThreshold = 0.f) noexcept
+	{
+		mDetectsSilence = inDetectsSilence;
+		mSilenceThreshold = inThreshold;
+	}
+	[[nodiscard]] bool DetectsSilence() const noexcept { return mDetectsSilence; }
+	[[nodiscard]] Float32 GetSilenceThreshold() const noexcept { return mSilenceThreshold; }
+
+	/// Opt-in caching of PullInput: a repeated pull for the same sample time and frame count
+	/// returns the buffers of the previous pull, and its silence flag, without rendering the
+	/// upstream again. The cached buffers must not have been processed in place meanwhile.
+	void SetCachesPulls(bool inCachesPulls) noexcept
+	{
+		mCachesPulls = inCachesPulls;
+		mPullCached = false;
+	}
+	[[nodiscard]] bool CachesPulls() const noexcept { return mCachesPulls; }
+
+	/// Diagnostic counts of cached pulls, which may be read from any thread.
+	[[nodiscard]] UInt64 GetPullCacheHits() const noexcept
+	{
+		return mPullCacheHits.load(std::memory_order_relaxed);
+	}
+	[[nodiscard]] UInt64 GetPullCacheMisses() const noexcept
+	{
+		return mPullCacheMisses.load(std::memory_order_relaxed);
+	}
+
 protected:
 	void Disconnect();
 
@@ -59,6 +94,17 @@ private:
 
 	// if from connection:
 	AudioUnitConnection mConnection{};
+
+	bool mDetectsSilence{ false };
+	Float32 mSilenceThreshold{ 0.f };
+
+	bool mCachesPulls{ false };
+	bool mPullCached{ false };
+	Float64 mCachedSampleTime{ 0. };
+	UInt32 mCachedFrames{ 0 };
+	AudioUnitRenderActionFlags mCachedSilence{ 0 };
+	std::atomic<UInt64> mPullCacheHits{ 0 };
+	std::atomic<UInt64> mPullCacheMisses{ 0 };
 };
 
 inline OSStatus AUInputElement::PullInputWithBufferList(AudioUnitRenderActionFlags& ioActionFlags,
@@ -88,6 +134,13 @@ inline OSStatus AUInputElement::PullInputWithBufferList(AudioUnitRenderActionFla
 			!(ABL::IsBogusAudioBufferList(inBufferList) & 1), kAudioUnitErr_InvalidPropertyValue);
 	}
 #endif
+	if (theResult == noErr) {
+		Meter(inBufferList, nFrames);
+		if (mDetectsSilence && (ioActionFlags & kAudioUnitRenderAction_OutputIsSilence) == 0 &&
+			IsBelowThreshold(inBufferList, nFrames, mSilenceThreshold)) {
+			ioActionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+		}
+	}
 	return theResult;
 }
 
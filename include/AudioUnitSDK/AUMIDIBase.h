@@ -11,6 +11,8 @@
 #include <AudioUnitSDK/AUBase.h>
 #include <AudioUnitSDK/AUUtility.h>
 
+// std
+#include <vector>
 
 #ifndef AUSDK_HAVE_XML_NAMES
 #define AUSDK_HAVE_XML_NAMES TARGET_OS_OSX // NOLINT(cppcoreguidelines-macro-usage)
@@ -97,6 +99,52 @@ public:
 		AudioUnitElement inElement, const void* inData, UInt32 inDataSize);
 
 protected:
+	/// Builds the registry of a `Unit` deriving from AUBase and AUMIDIBase: `base`, the registry of
+	/// its AUBase subclass, with the MIDI properties, which are dispatched to the Delegate methods.
+	template <typename Unit>
+	static AUPropertyRegistry MakePropertyRegistry(const AUPropertyRegistry& base)
+	{
+		std::vector<AudioUnitPropertyID> propertyIDs;
+#if AUSDK_HAVE_XML_NAMES
+		propertyIDs.push_back(kMusicDeviceProperty_MIDIXMLNames);
+#endif
+#if AUSDK_HAVE_MIDI_MAPPING
+		propertyIDs.insert(propertyIDs.end(),
+			{ kAudioUnitProperty_AllParameterMIDIMappings,
+				kAudioUnitProperty_HotMapParameterMIDIMapping,
+				kAudioUnitProperty_AddParameterMIDIMapping,
+				kAudioUnitProperty_RemoveParameterMIDIMapping });
+#endif
+		const AUPropertyRegistry::Handler::GetInfoFunction getInfo =
+			[](AUBase& unit, AudioUnitPropertyID inID, AudioUnitScope inScope,
+				AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable) -> OSStatus {
+			return static_cast<Unit&>(unit).DelegateGetPropertyInfo(
+				inID, inScope, inElement, outDataSize, outWritable);
+		};
+		const AUPropertyRegistry::Handler::GetFunction get =
+			[](AUBase& unit, AudioUnitPropertyID inID, AudioUnitScope inScope,
+				AudioUnitElement inElement, void* outData) -> OSStatus {
+			return static_cast<Unit&>(unit).DelegateGetProperty(inID, inScope, inElement, outData);
+		};
+		const AUPropertyRegistry::Handler::SetFunction set =
+			[](AUBase& unit, AudioUnitPropertyID inID, AudioUnitScope inScope,
+				AudioUnitElement inElement, const void* inData, UInt32 inDataSize) -> OSStatus {
+			return static_cast<Unit&>(unit).DelegateSetProperty(
+				inID, inScope, inElement, inData, inDataSize);
+		};
+
+		std::vector<AUPropertyRegistry::Handler> handlers;
+		for (const auto propertyID : propertyIDs) {
+			// the Delegate methods check the scope
+			handlers.push_back({ .id = propertyID,
+				.scopes = AUPropertyRegistry::kAnyScope,
+				.getInfo = getInfo,
+				.get = get,
+				.set = set });
+		}
+		return AUPropertyRegistry{ base, handlers };
+	}
+
 	// MIDI dispatch
 	virtual OSStatus HandleMIDIEvent(
 		UInt8 inStatus, UInt8 inChannel, UInt8 inData1, UInt8 inData2, UInt32 inStartFrame);
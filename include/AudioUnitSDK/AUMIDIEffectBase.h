@@ -30,12 +30,7 @@ public:
 	{
 		return AUMIDIBase::SysEx(inData, inLength);
 	}
-	OSStatus GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable) override;
-	OSStatus GetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, void* outData) override;
-	OSStatus SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, const void* inData, UInt32 inDataSize) override;
+	[[nodiscard]] const AUPropertyRegistry& GetPropertyRegistry() const override;
 };
 
 } // namespace ausdk
@@ -0,0 +1,253 @@
+/*!
+	@file		AudioUnitSDK/AUParameterTable.h
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#ifndef AudioUnitSDK_AUParameterTable_h
+#define AudioUnitSDK_AUParameterTable_h
+
+// module
+// clang-format off
+#include <AudioUnitSDK/AUConfig.h> // must come first
+// clang-format on
+#include <AudioUnitSDK/AUUtility.h>
+
+// OS
+#include <AudioToolbox/AudioUnitProperties.h>
+
+// std
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+namespace ausdk {
+
+/// Static description of one parameter of an element.
+struct AUParameterDescriptor {
+	AudioUnitParameterID id{};
+	AudioUnitParameterValue minValue{};
+	AudioUnitParameterValue maxValue{};
+	AudioUnitParameterValue defaultValue{};
+	AudioUnitParameterUnit unit{ kAudioUnitParameterUnit_Generic };
+	AudioUnitParameterOptions flags{ kAudioUnitParameterFlag_IsReadable |
+									 kAudioUnitParameterFlag_IsWritable };
+};
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUParameterTableView
+	@brief	Non-owning, type-erased view of an AUParameterTable.
+
+	Maps arbitrary (sparse, four-character-code) parameter IDs to dense indices in
+	[0, size()) with a minimal-branch perfect hash: one bucket lookup, one slot lookup and a
+	verifying key compare.
+*/
+class AUParameterTableView {
+public:
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	constexpr AUParameterTableView() = default;
+
+	constexpr AUParameterTableView(std::span<const AUParameterDescriptor> descriptors,
+		std::span<const UInt32> bucketSeeds, std::span<const UInt16> slots) noexcept
+		: mDescriptors{ descriptors }, mBucketSeeds{ bucketSeeds }, mSlots{ slots }
+	{
+	}
+
+	[[nodiscard]] constexpr bool empty() const noexcept { return mDescriptors.empty(); }
+	[[nodiscard]] constexpr size_t size() const noexcept { return mDescriptors.size(); }
+
+	[[nodiscard]] constexpr std::span<const AUParameterDescriptor> Descriptors() const noexcept
+	{
+		return mDescriptors;
+	}
+
+	[[nodiscard]] constexpr const AUParameterDescriptor& operator[](size_t index) const
+	{
+		return mDescriptors[index];
+	}
+
+	/// Returns the dense index of paramID, or npos if the table does not contain it.
+	[[nodiscard]] constexpr size_t IndexOf(AudioUnitParameterID paramID) const noexcept
+	{
+		if (mDescriptors.empty()) {
+			return npos;
+		}
+		const size_t index = mSlots[SlotOf(paramID, mBucketSeeds, mSlots.size())];
+		return mDescriptors[index].id == paramID ? index : npos;
+	}
+
+	[[nodiscard]] constexpr bool Contains(AudioUnitParameterID paramID) const noexcept
+	{
+		return IndexOf(paramID) != npos;
+	}
+
+	/// Hash shared by the table builder and the lookup.
+	[[nodiscard]] static constexpr UInt32 Hash(UInt32 key, UInt32 seed) noexcept
+	{
+		UInt32 hash = (key ^ seed) * 0x9E3779B1u; // NOLINT magic number
+		hash ^= hash >> 15u;                      // NOLINT magic number
+		hash *= 0x85EBCA77u;                      // NOLINT magic number
+		hash ^= hash >> 13u;                      // NOLINT magic number
+		return hash;
+	}
+
+	[[nodiscard]] static constexpr size_t BucketOf(UInt32 key, size_t bucketCount) noexcept
+	{
+		constexpr UInt32 kBucketSeed = 0x27D4EB2Fu;
+		return Hash(key, kBucketSeed) & (bucketCount - 1);
+	}
+
+	[[nodiscard]] static constexpr size_t SlotOf(
+		UInt32 key, std::span<const UInt32> bucketSeeds, size_t slotCount) noexcept
+	{
+		return Hash(key, bucketSeeds[BucketOf(key, bucketSeeds.size())]) & (slotCount - 1);
+	}
+
+private:
+	std::span<const AUParameterDescriptor> mDescriptors;
+	std::span<const UInt32> mBucketSeeds;
+	std::span<const UInt16> mSlots;
+};
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUParameterTable
+	@brief	Compile-time parameter descriptor table with a perfect-hash index.
+
+	Intended to be declared `static constexpr`, e.g.
+
+		static constexpr AUParameterTable kParams{ std::array{
+			AUParameterDescriptor{ .id = 'gain', .minValue = -96, .maxValue = 24 },
+			AUParameterDescriptor{ .id = 'freq', .minValue = 20, .maxValue = 20000,
+				.defaultValue = 1000, .unit = kAudioUnitParameterUnit_Hertz } } };
+
+	The index is built with hash-and-displace: IDs are grouped into buckets, and each bucket is
+	assigned the first seed that places all of its IDs into free slots. Duplicate IDs (or a failure
+	to find seeds) are a compile error in a constant expression and throw std::logic_error
+	otherwise.
+
+	A table is passed to AUElement::UseParameterTable() to back that element's parameters; the
+	table must outlive the element.
+*/
+template <size_t N>
+class AUParameterTable {
+	static_assert(N > 0, "an AUParameterTable must describe at least one parameter");
+	static_assert(N <= std::numeric_limits<UInt16>::max(), "too many parameters");
+
+	// About four IDs per bucket, and a slot table at most half full.
+	static constexpr size_t kBucketCount = std::bit_ceil((N + 3) / 4);
+	static constexpr size_t kSlotCount = std::bit_ceil(N) * 2;
+	static constexpr UInt32 kMaxSeedAttempts = 1u << 16u;
+
+public:
+	constexpr explicit AUParameterTable(const std::array<AUParameterDescriptor, N>& descriptors)
+		: mDescriptors{ descriptors }
+	{
+		BuildIndex();
+	}
+
+	[[nodiscard]] static constexpr size_t size() noexcept { return N; }
+
+	[[nodiscard]] constexpr AUParameterTableView View() const noexcept
+	{
+		return AUParameterTableView{ mDescriptors, mBucketSeeds, mSlots };
+	}
+
+	constexpr operator AUParameterTableView() const noexcept // NOLINT implicit conversion is OK
+	{
+		return View();
+	}
+
+	[[nodiscard]] constexpr size_t IndexOf(AudioUnitParameterID paramID) const noexcept
+	{
+		return View().IndexOf(paramID);
+	}
+
+	[[nodiscard]] constexpr const AUParameterDescriptor& operator[](size_t index) const
+	{
+		return mDescriptors[index];
+	}
+
+private:
+	constexpr void BuildIndex()
+	{
+		{
+			std::array<AudioUnitParameterID, N> sortedIDs{};
+			std::ranges::transform(mDescriptors, sortedIDs.begin(), &AUParameterDescriptor::id);
+			std::ranges::sort(sortedIDs);
+			if (std::ranges::adjacent_find(sortedIDs) != sortedIDs.end()) {
+				throw std::logic_error("AUParameterTable: duplicate parameter ID");
+			}
+		}
+
+		// Group descriptor indices by bucket, largest buckets first (they are the hardest to
+		// place).
+		std::array<UInt16, N> members{};
+		std::array<size_t, kBucketCount> bucketSizes{};
+		for (size_t i = 0; i < N; ++i) {
+			members[i] = static_cast<UInt16>(i);
+			++bucketSizes[AUParameterTableView::BucketOf(mDescriptors[i].id, kBucketCount)];
+		}
+		const auto bucketOf = [&](UInt16 member) {
+			return AUParameterTableView::BucketOf(mDescriptors[member].id, kBucketCount);
+		};
+		std::ranges::sort(members, [&](UInt16 lhs, UInt16 rhs) {
+			const auto lhsBucket = bucketOf(lhs);
+			const auto rhsBucket = bucketOf(rhs);
+			if (bucketSizes[lhsBucket] != bucketSizes[rhsBucket]) {
+				return bucketSizes[lhsBucket] > bucketSizes[rhsBucket];
+			}
+			return lhsBucket < rhsBucket;
+		});
+
+		std::array<bool, kSlotCount> occupied{};
+		std::array<size_t, N> candidateSlots{};
+		size_t begin = 0;
+		while (begin < N) {
+			const auto bucket = bucketOf(members[begin]);
+			const auto end = begin + bucketSizes[bucket];
+
+			UInt32 seed = 1;
+			for (;; ++seed) {
+				if (seed > kMaxSeedAttempts) {
+					throw std::logic_error("AUParameterTable: unable to build perfect hash");
+				}
+				bool placed = true;
+				for (size_t m = begin; m < end && placed; ++m) {
+					const auto slot =
+						AUParameterTableView::Hash(mDescriptors[members[m]].id, seed) &
+						(kSlotCount - 1);
+					const auto first = std::next(candidateSlots.begin(), std::ptrdiff_t(begin));
+					const auto last = std::next(candidateSlots.begin(), std::ptrdiff_t(m));
+					placed = !occupied[slot] && std::find(first, last, slot) == last;
+					candidateSlots[m] = slot;
+				}
+				if (placed) {
+					break;
+				}
+			}
+
+			mBucketSeeds[bucket] = seed;
+			for (size_t m = begin; m < end; ++m) {
+				occupied[candidateSlots[m]] = true;
+				mSlots[candidateSlots[m]] = members[m];
+			}
+			begin = end;
+		}
+	}
+
+	std::array<AUParameterDescriptor, N> mDescriptors;
+	std::array<UInt32, kBucketCount> mBucketSeeds{};
+	std::array<UInt16, kSlotCount> mSlots{};
+};
+
+} // namespace ausdk
+
+#endif // AudioUnitSDK_AUParameterTable_h
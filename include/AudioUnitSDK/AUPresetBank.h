@@ -0,0 +1,115 @@
+/*!
+	@file		AudioUnitSDK/AUPresetBank.h
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#ifndef AudioUnitSDK_AUPresetBank_h
+#define AudioUnitSDK_AUPresetBank_h
+
+// module
+// clang-format off
+#include <AudioUnitSDK/AUConfig.h> // must come first
+// clang-format on
+#include <AudioUnitSDK/AUBinaryState.h>
+#include <AudioUnitSDK/AUUtility.h>
+
+// OS
+#include <AudioToolbox/AUComponent.h>
+#include <CoreFoundation/CoreFoundation.h>
+
+// std
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace ausdk {
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUPresetBank
+	@brief	A read-only bank of factory presets, typically memory-mapped from a file.
+
+	Opening a bank only validates its header, so the cost does not grow with the number of
+	presets; names and states are decoded on demand. A bank is immutable once opened and may be
+	shared by all instances of an AudioUnit (see AUBase::SetFactoryPresetBank).
+
+	The file consists of little-endian 32-bit words:
+
+		header:		magic, version, preset count, reserved
+		index:		for each preset, in ascending order of preset number:
+					number, name offset, name size, state offset, state size
+		data:		UTF-8 names and AUBinaryState preset states, at word-aligned offsets
+*/
+class AUPresetBank {
+public:
+	static constexpr UInt32 kMagic = 'AUpb';
+	static constexpr UInt32 kVersion = 1;
+
+	/// A preset to be written by Encode.
+	struct Preset {
+		SInt32 number;
+		CFStringRef name;
+		CFDataRef state; // as from AUBase::SaveBinaryState
+	};
+
+	/// Memory-maps the bank file at `path`. Throws kAudioUnitErr_InvalidFile if it cannot be
+	/// mapped or is not a bank.
+	explicit AUPresetBank(const char* path);
+
+	/// Uses a bank in memory, e.g. a resource linked into the binary, which must outlive this.
+	explicit AUPresetBank(std::span<const UInt8> data);
+
+	AUPresetBank(const AUPresetBank&) = delete;
+	AUPresetBank(AUPresetBank&&) = delete;
+	AUPresetBank& operator=(const AUPresetBank&) = delete;
+	AUPresetBank& operator=(AUPresetBank&&) = delete;
+
+	~AUPresetBank();
+
+	[[nodiscard]] size_t Count() const noexcept { return mCount; }
+
+	/// Returns the position of the preset with `number`: O(1) when the presets are numbered
+	/// consecutively from 0, as is usual, otherwise a binary search.
+	[[nodiscard]] std::optional<size_t> Find(SInt32 number) const;
+
+	[[nodiscard]] SInt32 NumberAt(size_t index) const;
+	[[nodiscard]] Owned<CFStringRef> NameAt(size_t index) const;
+
+	/// The preset's state, for AUBase::RestoreBinaryState. The data references the bank's memory
+	/// without copying, so it must not outlive the bank.
+	[[nodiscard]] Owned<CFDataRef> StateAt(size_t index) const;
+
+	/// Returns a CFArray of AUPreset for kAudioUnitProperty_FactoryPresets. The presets and their
+	/// names are created on the first call and owned by the bank.
+	OSStatus CopyPresets(CFArrayRef* outData) const;
+
+	/// Builds the contents of a bank file, e.g. in a build tool. The presets are sorted by number.
+	[[nodiscard]] static std::vector<UInt8> Encode(std::span<const Preset> presets);
+
+private:
+	static constexpr size_t kHeaderSize = 4 * AUBinaryState::kWordSize;
+	static constexpr size_t kIndexEntrySize = 5 * AUBinaryState::kWordSize;
+
+	struct IndexEntry {
+		SInt32 number;
+		std::span<const UInt8> name;
+		std::span<const UInt8> state;
+	};
+
+	void Open();
+	[[nodiscard]] IndexEntry EntryAt(size_t index) const;
+
+	std::span<const UInt8> mData;
+	void* mMapping{ nullptr };
+	size_t mCount{ 0 };
+
+	mutable std::once_flag mPresetsCreated;
+	mutable std::vector<AUPreset> mPresets;
+	mutable std::vector<Owned<CFStringRef>> mPresetNames;
+};
+
+} // namespace ausdk
+
+#endif // AudioUnitSDK_AUPresetBank_h
@@ -0,0 +1,126 @@
+/*!
+	@file		AudioUnitSDK/AUPropertyChangeQueue.h
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#ifndef AudioUnitSDK_AUPropertyChangeQueue_h
+#define AudioUnitSDK_AUPropertyChangeQueue_h
+
+// module
+// clang-format off
+#include <AudioUnitSDK/AUConfig.h> // must come first
+// clang-format on
+
+// OS
+#include <AudioToolbox/AUComponent.h>
+
+// std
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ausdk {
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUPropertyChangeQueue
+	@brief	Collects property change notifications on any thread, including the render thread,
+			for delivery on a non-realtime thread.
+
+	Changes are coalesced: a change posted while an identical one (same property, scope and
+	element) is pending is delivered once. The queue is a fixed table, so posting never allocates
+	or blocks. A change keeps its slot until a Drain finds it delivered and not posted again since,
+	which then frees the slot for other changes. Changes are delivered in table order rather than
+	the order in which they were posted.
+*/
+class AUPropertyChangeQueue {
+public:
+	struct Change {
+		AudioUnitPropertyID propertyID{ 0 };
+		AudioUnitScope scope{ 0 };
+		AudioUnitElement element{ 0 };
+
+		bool operator==(const Change&) const noexcept = default;
+	};
+
+	/// The number of distinct changes the queue can hold.
+	static constexpr size_t kCapacity = 256;
+
+	AUPropertyChangeQueue() = default;
+	~AUPropertyChangeQueue() { StopDispatcher(); }
+
+	AUPropertyChangeQueue(const AUPropertyChangeQueue&) = delete;
+	AUPropertyChangeQueue(AUPropertyChangeQueue&&) = delete;
+	AUPropertyChangeQueue& operator=(const AUPropertyChangeQueue&) = delete;
+	AUPropertyChangeQueue& operator=(AUPropertyChangeQueue&&) = delete;
+
+	/// Realtime-safe. Returns false, and the change is lost, if every slot holds another change
+	/// which has not been drained twice since it was last posted.
+	bool Post(const Change& change) noexcept;
+
+	/// Calls `deliver` with each pending change, returning their number. A change posted again
+	/// while being delivered stays pending. May be called by one thread at a time.
+	size_t Drain(const std::function<void(const Change&)>& deliver);
+
+	/// The number of changes lost because the queue was full.
+	[[nodiscard]] UInt64 DroppedCount() const noexcept
+	{
+		return mDroppedCount.load(std::memory_order_relaxed);
+	}
+
+	/// Drains the queue with `deliver` every `interval`, on a thread of its own, until
+	/// StopDispatcher. Not realtime-safe.
+	void StartDispatcher(
+		std::chrono::milliseconds interval, std::function<void(const Change&)> deliver);
+
+	/// Stops the dispatcher thread, if running, after a final Drain. Not realtime-safe.
+	void StopDispatcher();
+
+	[[nodiscard]] bool IsDispatching() const noexcept { return mDispatcher.joinable(); }
+
+private:
+	// A slot's word holds its state in the low bits and, above them, a generation which is
+	// incremented whenever the slot is freed, so that a Post which read the change before the
+	// slot was reused cannot mark the new change pending.
+	enum SlotState : UInt32 { kSlotEmpty, kSlotClaimed, kSlotDelivered, kSlotPending };
+	static constexpr UInt32 kStateMask = 3;
+	static constexpr UInt32 kGenerationIncrement = kStateMask + 1;
+
+	struct Slot {
+		std::atomic<UInt32> word{ kSlotEmpty };
+		// Written while the slot is claimed; atomic as a Post may read them as it is reused.
+		std::atomic<AudioUnitPropertyID> propertyID{ 0 };
+		std::atomic<AudioUnitScope> scope{ 0 };
+		std::atomic<AudioUnitElement> element{ 0 };
+
+		[[nodiscard]] Change Load() const noexcept
+		{
+			return { .propertyID = propertyID.load(std::memory_order_relaxed),
+				.scope = scope.load(std::memory_order_relaxed),
+				.element = element.load(std::memory_order_relaxed) };
+		}
+	};
+
+	[[nodiscard]] static size_t Hash(const Change& change) noexcept;
+	[[nodiscard]] static constexpr UInt32 SlotWord(UInt32 word, SlotState state) noexcept
+	{
+		return (word & ~kStateMask) | state;
+	}
+
+	std::array<Slot, kCapacity> mSlots;
+	std::atomic<UInt64> mDroppedCount{ 0 };
+
+	std::thread mDispatcher;
+	std::mutex mDispatcherMutex;
+	std::condition_variable mDispatcherWakeup;
+	bool mDispatcherStopping{ false };
+};
+
+} // namespace ausdk
+
+#endif // AudioUnitSDK_AUPropertyChangeQueue_h
@@ -0,0 +1,103 @@
+/*!
+	@file		AudioUnitSDK/AUPropertyRegistry.h
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#ifndef AudioUnitSDK_AUPropertyRegistry_h
+#define AudioUnitSDK_AUPropertyRegistry_h
+
+// clang-format off
+#include <AudioUnitSDK/AUConfig.h> // must come first
+// clang-format on
+
+// OS
+#include <AudioToolbox/AUComponent.h>
+
+// std
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ausdk {
+
+class AUBase;
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUPropertyRegistry
+	@brief	A table of property handlers, built once per class.
+
+	AUBase dispatches the properties it implements itself; the properties added by a subclass are
+	reached through the default implementations of AUBase::GetPropertyInfo, GetProperty and
+	SetProperty, which look up the registry returned by AUBase::GetPropertyRegistry. A subclass
+	builds its registry from its base class's, adding or replacing handlers, so each property is
+	found with a single lookup rather than by a chain of overrides. Overrides of those virtual
+	methods still take precedence, as long as they defer to the base class for other properties.
+
+	The handlers are sorted by ID. IDs below kDenseIDCount, which include the standard
+	kAudioUnitProperty_ constants, are found in constant time; others by binary search.
+*/
+class AUPropertyRegistry {
+public:
+	static constexpr UInt32 kAnyScope = ~0u;
+
+	/// The bit for `scope` in Handler::scopes.
+	[[nodiscard]] static constexpr UInt32 ScopeMask(AudioUnitScope scope) noexcept
+	{
+		return scope < 32u ? 1u << scope : 0u; // NOLINT magic number
+	}
+
+	/// Handles one property. The functions receive the AUBase which owns the registry; a null
+	/// function means the property cannot be gotten or set.
+	struct Handler {
+		using GetInfoFunction = OSStatus (*)(AUBase& unit, AudioUnitPropertyID inID,
+			AudioUnitScope inScope, AudioUnitElement inElement, UInt32& outDataSize,
+			bool& outWritable);
+		using GetFunction = OSStatus (*)(AUBase& unit, AudioUnitPropertyID inID,
+			AudioUnitScope inScope, AudioUnitElement inElement, void* outData);
+		using SetFunction = OSStatus (*)(AUBase& unit, AudioUnitPropertyID inID,
+			AudioUnitScope inScope, AudioUnitElement inElement, const void* inData,
+			UInt32 inDataSize);
+
+		AudioUnitPropertyID id{ 0 };
+		UInt32 scopes{ ScopeMask(kAudioUnitScope_Global) }; // others are kAudioUnitErr_InvalidScope
+		UInt32 dataSize{ 0 };
+		bool writable{ false };
+		GetInfoFunction getInfo{ nullptr }; // if the size or writability varies
+		GetFunction get{ nullptr };
+		SetFunction set{ nullptr }; // a set with less than dataSize bytes is rejected
+	};
+
+	AUPropertyRegistry() = default;
+	explicit AUPropertyRegistry(std::span<const Handler> handlers);
+
+	/// Inherits the handlers of `base`, adding `handlers`, which replace those with the same IDs.
+	AUPropertyRegistry(const AUPropertyRegistry& base, std::span<const Handler> handlers);
+
+	[[nodiscard]] const Handler* Find(AudioUnitPropertyID inID) const noexcept;
+
+	/// The registered handlers, in order of ID.
+	[[nodiscard]] std::span<const Handler> Handlers() const noexcept { return mHandlers; }
+
+	OSStatus GetPropertyInfo(AUBase& unit, AudioUnitPropertyID inID, AudioUnitScope inScope,
+		AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable) const;
+	OSStatus GetProperty(AUBase& unit, AudioUnitPropertyID inID, AudioUnitScope inScope,
+		AudioUnitElement inElement, void* outData) const;
+	OSStatus SetProperty(AUBase& unit, AudioUnitPropertyID inID, AudioUnitScope inScope,
+		AudioUnitElement inElement, const void* inData, UInt32 inDataSize) const;
+
+private:
+	static constexpr AudioUnitPropertyID kDenseIDCount = 128;
+
+	void Add(std::span<const Handler> handlers);
+	[[nodiscard]] const Handler* FindInScope(
+		AudioUnitPropertyID inID, AudioUnitScope inScope, OSStatus& outError) const noexcept;
+
+	std::vector<Handler> mHandlers;
+	std::array<UInt16, kDenseIDCount> mDenseIndex{}; // 1 + index into mHandlers, or 0
+};
+
+} // namespace ausdk
+
+#endif // AudioUnitSDK_AUPropertyRegistry_h
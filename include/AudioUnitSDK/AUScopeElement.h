@@ -10,6 +10,8 @@
 #include <AudioUnitSDK/AUConfig.h> // must come first
 // clang-format on
 #include <AudioUnitSDK/AUBuffer.h>
+#include <AudioUnitSDK/AUEpoch.h>
+#include <AudioUnitSDK/AUParameterTable.h>
 #include <AudioUnitSDK/AUUtility.h>
 #include <AudioUnitSDK/ComponentBase.h>
 
@@ -18,8 +20,16 @@
 
 // std
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <concepts>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -55,6 +65,16 @@ public:
 
 	T load(std::memory_order m = std::memory_order_seq_cst) const { return mValue.load(m); }
 	void store(T v, std::memory_order m = std::memory_order_seq_cst) { mValue.store(v, m); }
+	T exchange(T v, std::memory_order m = std::memory_order_seq_cst)
+	{
+		return mValue.exchange(v, m);
+	}
+
+	T fetch_or(T v, std::memory_order m = std::memory_order_seq_cst)
+		requires std::is_integral_v<T>
+	{
+		return mValue.fetch_or(v, m);
+	}
 
 	operator T() const { return load(); } // NOLINT implicit conversions OK
 
@@ -85,6 +105,7 @@ public:
 
 	[[nodiscard]] bool empty() const noexcept { return mImpl.empty(); }
 	[[nodiscard]] size_t size() const noexcept { return mImpl.size(); }
+	void clear() noexcept { mImpl.clear(); }
 	[[nodiscard]] const_iterator begin() const noexcept { return mImpl.begin(); }
 	[[nodiscard]] const_iterator end() const noexcept { return mImpl.end(); }
 	iterator begin() noexcept { return mImpl.begin(); }
@@ -151,12 +172,38 @@ public:
 	};
 
 	ItemProxy operator[](Key k) { return ItemProxy{ *this, k }; }
+
+	/// Inserts or assigns a batch of items, which must be sorted by unique key, with a single
+	/// linear merge rather than one vector insertion per item.
+	void insert_or_assign_sorted(std::span<const KVPair> items)
+	{
+		Impl merged;
+		merged.reserve(mImpl.size() + items.size());
+		auto existing = mImpl.begin();
+		for (const auto& item : items) {
+			while (existing != mImpl.end() && existing->first < item.first) {
+				merged.push_back(std::move(*existing++));
+			}
+			if (existing != mImpl.end() && existing->first == item.first) {
+				++existing; // replaced by item
+			}
+			merged.push_back(item);
+		}
+		std::move(existing, mImpl.end(), std::back_inserter(merged));
+		mImpl = std::move(merged);
+	}
 };
 
 // ____________________________________________________________________________
 //
 class AUIOElement;
 
+/// A parameter ID and value, as transferred by AUElement::SetParameters and GetParameters.
+struct AUParameterIDValue {
+	AudioUnitParameterID mParameterID;
+	AudioUnitParameterValue mValue;
+};
+
 /// An organizational unit for parameters, with a name.
 class AUElement {
 public:
@@ -174,6 +221,9 @@ public:
 
 	virtual UInt32 GetNumberOfParameters()
 	{
+		if (!mParameterTable.empty()) {
+			return static_cast<UInt32>(mParameterTable.size());
+		}
 		return mUseIndexedParameters ? static_cast<UInt32>(mIndexedParameters.size())
 									 : static_cast<UInt32>(mParameters.size());
 	}
@@ -194,10 +244,111 @@ public:
 		const AudioUnitParameterEvent& inEvent, UInt32 inSliceOffsetInBuffer,
 		UInt32 inSliceDurationFrames, bool okWhenInitialized = false);
 
+	/// Sets several parameters as one transaction: GetParameters() observes either none or all
+	/// of the new values, and change tracking publishes the batch once. Unless parameters may
+	/// still be defined (see SetParameter), every ID must exist; otherwise nothing is set and
+	/// kAudioUnitErr_InvalidParameter is thrown. Concurrent transactions on one element are
+	/// serialized.
+	void SetParameters(std::span<const AUParameterIDValue> values, bool okWhenInitialized = false);
+
+	/// Fills in the values for the IDs in `ioValues` as a snapshot which is consistent with
+	/// respect to SetParameters(). Never blocks or throws, so it is safe on the render thread.
+	/// Returns kAudioUnitErr_InvalidParameter if an ID is unknown, leaving the values undefined.
+	/// If a transaction was in progress on every attempt, it returns
+	/// kAudioUnitErr_CannotDoInCurrentContext and the values may mix old and new ones, in which
+	/// case the caller should keep its previous state until the next render.
+	[[nodiscard]] OSStatus GetParameters(std::span<AUParameterIDValue> ioValues) const noexcept;
+
+	/// The position of paramID in the element's storage, as used by GetParametersAtIndices and
+	/// SetParametersAtIndices, or AUParameterTableView::npos.
+	[[nodiscard]] size_t IndexOfParameter(AudioUnitParameterID paramID) const noexcept
+	{
+		return ParameterIndex(paramID);
+	}
+
+	/// Bulk access by storage position, without ID lookups, e.g. for a dense pass over many
+	/// parameters per render slice. `values` has one entry per index; setting is one
+	/// transaction, as with SetParameters. GetParametersAtIndices is realtime-safe;
+	/// SetParametersAtIndices waits for other writers' transactions, so the render thread must
+	/// use TrySetParametersAtIndices instead.
+	void GetParametersAtIndices(
+		std::span<const size_t> indices, std::span<AudioUnitParameterValue> values) const;
+	void SetParametersAtIndices(
+		std::span<const size_t> indices, std::span<const AudioUnitParameterValue> values) noexcept;
+	/// As SetParametersAtIndices, but for the render thread: returns false, having set nothing,
+	/// instead of waiting for another writer's transaction; the caller should try again on a
+	/// later render cycle.
+	bool TrySetParametersAtIndices(
+		std::span<const size_t> indices, std::span<const AudioUnitParameterValue> values) noexcept;
+
 	[[nodiscard]] AUBase& GetAudioUnit() const noexcept { return mAudioUnit; }
 
 	void SaveState(AudioUnitScope scope, CFMutableDataRef data);
-	const UInt8* RestoreState(const UInt8* state);
+
+	/// Restores values written by SaveState from the bytes in [state, end), returning the
+	/// position after them. Throws kAudioUnitErr_InvalidPropertyValue if they run past `end`.
+	const UInt8* RestoreState(const UInt8* state, const UInt8* end);
+
+	/// The number of parameters in the element's own storage, and therefore an upper bound on
+	/// those visited by ForEachSavedParameter (GetNumberOfParameters may be overridden).
+	[[nodiscard]] size_t ParameterCount() const noexcept;
+
+	/// Invokes `f(paramID, value)` for each parameter which SaveState saves, i.e. skipping those
+	/// flagged OmitFromPresets or MeterReadOnly, in storage order. Not realtime-safe.
+	template <typename F>
+		requires std::invocable<F&, AudioUnitParameterID, AudioUnitParameterValue>
+	void ForEachSavedParameter(AudioUnitScope scope, F&& f)
+	{
+		const auto metadata = PrepareParameterMetadata(scope);
+		const size_t numParams = ParameterCount();
+		for (size_t i = 0; i < numParams; ++i) {
+			const auto paramID = ParameterIDAtIndex(i);
+			if (!IsOmittedFromState(scope, metadata.get(), i, paramID)) {
+				f(paramID, ValueAtIndex(i).load(std::memory_order_acquire));
+			}
+		}
+	}
+
+	/// Applies saved parameter values as RestoreState does: undefined IDs are defined before
+	/// Initialize and ignored afterwards, and the values are set as one transaction, or added to
+	/// the unit's restoring parameter snapshot if there is one. May remove entries from `values`.
+	void RestoreParameters(std::vector<AUParameterIDValue>& values);
+
+	/// Like ForEachSavedParameter, but only visits the parameters whose values differ from their
+	/// delta-state base: the value at the last CommitStateBase() or, with `fromDefaults` or when
+	/// there is no committed base, the default from GetParameterInfo. Parameters without a known
+	/// base value, e.g. all of them while the unit is uninitialized, are always visited.
+	template <typename F>
+		requires std::invocable<F&, AudioUnitParameterID, AudioUnitParameterValue>
+	void ForEachChangedSavedParameter(AudioUnitScope scope, bool fromDefaults, F&& f)
+	{
+		const auto metadata = PrepareParameterMetadata(scope);
+		const size_t numParams = ParameterCount();
+		for (size_t i = 0; i < numParams; ++i) {
+			const auto paramID = ParameterIDAtIndex(i);
+			if (IsOmittedFromState(scope, metadata.get(), i, paramID)) {
+				continue;
+			}
+			const auto value = ValueAtIndex(i).load(std::memory_order_acquire);
+			const auto base = StateBaseAtIndex(i, metadata.get(), fromDefaults);
+			if (!base || std::bit_cast<UInt32>(*base) != std::bit_cast<UInt32>(value)) {
+				f(paramID, value);
+			}
+		}
+	}
+
+	/// Appends the delta-state base values (see ForEachChangedSavedParameter) of the saved
+	/// parameters to `values`, e.g. to revert the element to its base before applying a delta.
+	void AppendStateBase(
+		AudioUnitScope scope, bool fromDefaults, std::vector<AUParameterIDValue>& values);
+
+	/// Makes the current values, overridden by any `pending` ones which have been restored but not
+	/// applied yet (see AUBase::DefersParameterRestore), the delta-state base. The snapshot is
+	/// only allocated once delta states are used, and is discarded when the parameters are
+	/// redefined. Not realtime-safe.
+	void CommitStateBase(std::span<const AUParameterIDValue> pending);
+
+	[[nodiscard]] bool HasStateBase() const noexcept { return mHasStateBase; }
 
 	[[nodiscard]] Owned<CFStringRef> GetName() const noexcept { return mElementName; }
 	void SetName(CFStringRef inName) noexcept { mElementName = inName; }
@@ -206,15 +357,205 @@ public:
 
 	virtual void UseIndexedParameters(UInt32 inNumberOfParameters);
 
+	/// Incremented whenever one of this element's parameter values changes (via SetParameter,
+	/// and therefore SetScheduledEvent and RestoreState). Kernels can compare it against the value
+	/// seen on their previous render to skip change processing entirely.
+	[[nodiscard]] UInt64 GetParameterGeneration() const noexcept
+	{
+		return mParameterGeneration.load(std::memory_order_acquire);
+	}
+
+	/// Invokes `f(paramID)` once for each parameter which has changed since the previous call, and
+	/// clears the change flags. Lock-free and allocation-free; intended for a single consumer,
+	/// typically the render thread, which reads the new values with GetParameter() in `f`. A
+	/// parameter is reported as changed at least once after each change.
+	template <typename F>
+		requires std::invocable<F&, AudioUnitParameterID>
+	void ConsumeChangedParameters(F&& f)
+	{
+		for (size_t word = 0; word < mChangedParameters.size(); ++word) {
+			auto bits = mChangedParameters[word].exchange(0, std::memory_order_acquire);
+			while (bits != 0) {
+				const auto bit = static_cast<size_t>(std::countr_zero(bits));
+				bits &= bits - 1;
+				f(ParameterIDAtIndex(word * kChangeFlagsPerWord + bit));
+			}
+		}
+	}
+
+	/// Invokes `f(paramID, value)` once for each parameter which has changed since the previous
+	/// call, with its current value. These change flags are separate from those cleared by
+	/// ConsumeChangedParameters, so that a consumer on another thread, such as a UI or control
+	/// surface, can follow changes at its own rate while kernels consume theirs. Changes between
+	/// two calls are coalesced. Lock-free and allocation-free; for a single consumer.
+	template <typename F>
+		requires std::invocable<F&, AudioUnitParameterID, AudioUnitParameterValue>
+	void ConsumeParameterChangeFeed(F&& f)
+	{
+		for (size_t word = 0; word < mFedParameters.size(); ++word) {
+			auto bits = mFedParameters[word].exchange(0, std::memory_order_acquire);
+			while (bits != 0) {
+				const auto index =
+					word * kChangeFlagsPerWord + static_cast<size_t>(std::countr_zero(bits));
+				bits &= bits - 1;
+				f(ParameterIDAtIndex(index), ValueAtIndex(index).load(std::memory_order_acquire));
+			}
+		}
+	}
+
+	/// Flags a parameter as changed without setting its value, e.g. from a SetScheduledEvent
+	/// override which implements ramping itself.
+	void MarkParameterChanged(AudioUnitParameterID paramID);
+
+	/// Flags every parameter as changed, e.g. so that kernels recompute all derived state.
+	void MarkAllParametersChanged() noexcept;
+
+	/// Backs this element's parameters with a compile-time descriptor table (see
+	/// AUParameterTable), giving O(1) access for sparse and four-character-code IDs. Values are
+	/// initialized to the descriptors' defaults, and any indexed or map-backed parameters are
+	/// discarded. The table must outlive the element. Call this before accessing any parameters.
+	virtual void UseParameterTable(AUParameterTableView table);
+
+	[[nodiscard]] AUParameterTableView GetParameterTable() const noexcept
+	{
+		return mParameterTable;
+	}
+
+	/// Render-path accessors for an element using a parameter table. `index` is the parameter's
+	/// position in the table, typically a constant-evaluated AUParameterTable::IndexOf().
+	[[nodiscard]] AudioUnitParameterValue GetParameterAtTableIndex(size_t index) const noexcept
+	{
+		return TableValue(index).load(std::memory_order_acquire);
+	}
+	void SetParameterAtTableIndex(size_t index, AudioUnitParameterValue value) noexcept
+	{
+		TableValue(index).store(value, std::memory_order_release);
+		MarkChangedAtIndex(index);
+	}
+
+	/// The result of AUBase::GetParameterInfo for one of this element's parameters.
+	struct ParameterMetadata {
+		AudioUnitParameterInfo info{};
+		OSStatus status{ kAudioUnitErr_InvalidParameter };
+	};
+
+	/// Returns a copy of the cached GetParameterInfo result for paramID, or nullopt if the unit is
+	/// not initialized or the element has no such parameter. As from GetParameterInfo, names in
+	/// the info are the caller's to release when kAudioUnitParameterFlag_CFNameRelease is set.
+	/// On first use after Initialize, the cache is built for all of the element's parameters; it
+	/// is immutable until the parameters are redefined, the unit signals a ParameterList or
+	/// ParameterInfo change, or Cleanup. Thread-safe; not realtime-safe.
+	[[nodiscard]] std::optional<ParameterMetadata> CopyParameterMetadata(
+		AudioUnitScope scope, AudioUnitParameterID paramID);
+
+	/// Marks the metadata cache stale, so that its next user rebuilds it. Only bumps a counter,
+	/// so it is realtime-safe: the stale cache is freed by the next rebuild, on that thread.
+	void InvalidateParameterMetadata() noexcept
+	{
+		mParameterMetadataGeneration.fetch_add(1, std::memory_order_release);
+	}
+
 	virtual AUIOElement* AsIOElement() { return nullptr; }
 
 private:
 	using ParameterValue = AtomicValue<float>;
 
+	// Table-backed values are grouped into cache-line-aligned blocks so that they never share a
+	// line with other element state. The blocks are heap-allocated by the vector, through the
+	// aligned operator new which the deployment targets provide.
+	static constexpr size_t kParametersPerBlock = kCacheLineSize / sizeof(ParameterValue);
+	struct alignas(kCacheLineSize) ParameterBlock {
+		std::array<ParameterValue, kParametersPerBlock> values{};
+	};
+
+	[[nodiscard]] const ParameterValue& TableValue(size_t index) const noexcept
+	{
+		return mParameterBlocks[index / kParametersPerBlock].values[index % kParametersPerBlock];
+	}
+	[[nodiscard]] ParameterValue& TableValue(size_t index) noexcept
+	{
+		return mParameterBlocks[index / kParametersPerBlock].values[index % kParametersPerBlock];
+	}
+
+	// Position of a parameter in whichever storage is in use, or kInvalidIndex.
+	static constexpr size_t kInvalidIndex = AUParameterTableView::npos;
+	[[nodiscard]] size_t ParameterIndex(AudioUnitParameterID paramID) const noexcept;
+	[[nodiscard]] AudioUnitParameterID ParameterIDAtIndex(size_t index) const;
+	[[nodiscard]] const ParameterValue& ValueAtIndex(size_t index) const;
+	[[nodiscard]] ParameterValue& ValueAtIndex(size_t index);
+
+	// One change flag per parameter, addressed by its index, in each of mChangedParameters and
+	// mFedParameters (for ConsumeParameterChangeFeed).
+	using ChangeFlags = AtomicValue<UInt64>;
+	static constexpr size_t kChangeFlagsPerWord = 64;
+
+	void SetChangeFlag(size_t index) noexcept
+	{
+		if (index < mChangedParameters.size() * kChangeFlagsPerWord) {
+			const size_t word = index / kChangeFlagsPerWord;
+			const UInt64 bit = UInt64{ 1 } << (index % kChangeFlagsPerWord);
+			mChangedParameters[word].fetch_or(bit, std::memory_order_release);
+			mFedParameters[word].fetch_or(bit, std::memory_order_release);
+		}
+	}
+	void MarkChangedAtIndex(size_t index) noexcept
+	{
+		SetChangeFlag(index);
+		mParameterGeneration.fetch_add(1, std::memory_order_release);
+	}
+	void ResizeChangeFlags(size_t numParameters);
+
+	// Defines and/or sets many map-backed parameters with one sort and merge. Not realtime-safe.
+	void DefineParameters(std::span<const AUParameterIDValue> values);
+
+	// An immutable snapshot of the metadata for all of the element's parameters. Readers hold a
+	// reference for as long as they use it, so a rebuild on another thread never frees it early.
+	struct ParameterMetadataCache {
+		UInt64 generation{ 0 }; // of mParameterMetadataGeneration when it was built
+		std::vector<ParameterMetadata> entries; // indexed like the values
+		std::vector<Owned<CFStringRef>> names;
+	};
+
+	// Returns the current metadata, rebuilding it if stale, or null while the unit is
+	// uninitialized.
+	std::shared_ptr<const ParameterMetadataCache> PrepareParameterMetadata(AudioUnitScope scope);
+	bool IsOmittedFromState(AudioUnitScope scope, const ParameterMetadataCache* metadata,
+		size_t index, AudioUnitParameterID paramID);
+	[[nodiscard]] std::optional<AudioUnitParameterValue> StateBaseAtIndex(
+		size_t index, const ParameterMetadataCache* metadata, bool fromDefaults) const noexcept
+	{
+		if (!fromDefaults && mHasStateBase) {
+			return mStateBase[index];
+		}
+		if (metadata != nullptr && metadata->entries[index].status == noErr) {
+			return metadata->entries[index].info.defaultValue;
+		}
+		return std::nullopt;
+	}
+
+	// Sequence lock for SetParameters/GetParameters; odd while a transaction is being written.
+	UInt32 BeginParameterTransaction() noexcept;
+	bool TryBeginParameterTransaction(UInt32& outSequence) noexcept;
+	// Writes the values of a transaction begun at `sequence`, and ends it.
+	void StoreParameterTransaction(std::span<const AUParameterIDValue> values, UInt32 sequence);
+	void StoreParametersAtIndices(std::span<const size_t> indices,
+		std::span<const AudioUnitParameterValue> values, UInt32 sequence) noexcept;
+
 	AUBase& mAudioUnit;
 	flat_map<AudioUnitParameterID, ParameterValue> mParameters;
 	bool mUseIndexedParameters;
 	std::vector<ParameterValue> mIndexedParameters;
+	AUParameterTableView mParameterTable;
+	std::vector<ParameterBlock> mParameterBlocks;
+	std::vector<ChangeFlags> mChangedParameters;
+	std::vector<ChangeFlags> mFedParameters;
+	std::atomic<UInt64> mParameterGeneration{ 0 };
+	std::atomic<UInt32> mParameterSequence{ 0 };
+	std::mutex mParameterMetadataMutex; // guards the mParameterMetadata pointer itself
+	std::shared_ptr<const ParameterMetadataCache> mParameterMetadata;
+	std::atomic<UInt64> mParameterMetadataGeneration{ 0 };
+	std::vector<AudioUnitParameterValue> mStateBase; // indexed like the values
+	bool mHasStateBase{ false };
 	Owned<CFStringRef> mElementName;
 };
 
@@ -222,6 +563,14 @@ private:
 // ____________________________________________________________________________
 //
 
+/// One channel's levels, as measured by AUIOElement's metering (see
+/// AUIOElement::SetMeteringEnabled) and transferred by kAUSDKProperty_Meters.
+struct AUChannelMeterValues {
+	Float32 mPeak;     // the largest magnitude since the previous read
+	Float32 mRMS;      // over the most recently measured render slice
+	UInt32 mClipCount; // samples of magnitude above 1 since metering was enabled
+};
+
 /// A subclass of AUElement which represents an input or output bus, and has an associated
 /// audio format and buffers.
 class AUIOElement : public AUElement {
@@ -282,6 +631,9 @@ public:
 
 	void CopyBufferListTo(AudioBufferList& abl) const { mIOBuffer.CopyBufferListTo(abl); }
 	void CopyBufferContentsTo(AudioBufferList& abl) const { mIOBuffer.CopyBufferContentsTo(abl); }
+	/// Silences the prepared buffer list, pointing the element's own buffers at the
+	/// AUZeroBufferPool rather than clearing them if enough zeros have been reserved.
+	void SilenceBuffer() { mIOBuffer.Silence(); }
 	[[nodiscard]] bool IsInterleaved() const noexcept { return ASBD::IsInterleaved(mStreamFormat); }
 	[[nodiscard]] UInt32 NumberChannels() const noexcept { return mStreamFormat.mChannelsPerFrame; }
 	[[nodiscard]] UInt32 NumberInterleavedChannels() const noexcept
@@ -298,6 +650,28 @@ public:
 
 	virtual OSStatus RemoveAudioChannelLayout();
 
+	/// Opt-in metering of the audio passing through the element: after each render of an
+	/// output, in AUBase::DoRender, and after each pull of an input. Only 32-bit float formats
+	/// are measured. Not realtime-safe.
+	void SetMeteringEnabled(bool inEnabled);
+
+	[[nodiscard]] bool IsMeteringEnabled() const noexcept { return mMeters.Get() != nullptr; }
+
+	/// Render thread: measures the first `inFrames` frames of `inBufferList`, which is in the
+	/// element's format, with one SIMD pass over each channel. Does nothing unless metering is
+	/// enabled.
+	void Meter(const AudioBufferList& inBufferList, UInt32 inFrames) noexcept;
+
+	/// Whether every sample of the first `inFrames` frames of `inBufferList`, which is in the
+	/// element's format, has a magnitude of at most `inThreshold`. Always false unless the
+	/// format is 32-bit float. Realtime-safe.
+	[[nodiscard]] bool IsBelowThreshold(
+		const AudioBufferList& inBufferList, UInt32 inFrames, Float32 inThreshold) const noexcept;
+
+	/// Copies the levels of up to outValues.size() channels, and restarts their peaks. Returns
+	/// the number of channels copied, or 0 if metering is disabled. Not realtime-safe.
+	size_t ReadMeters(std::span<AUChannelMeterValues> outValues);
+
 	/*! @fn AsIOElement*/
 	AUIOElement* AsIOElement() override { return this; }
 
@@ -314,6 +688,20 @@ private:
 	AUBufferList mIOBuffer; // for input: input proc buffer, only allocated when needed
 							// for output: output cache, usually allocated early on
 	bool mWillAllocate{ false };
+
+	struct ChannelMeter {
+		std::atomic<Float32> peak{ 0.f };
+		std::atomic<Float32> rms{ 0.f };
+		std::atomic<UInt32> clipCount{ 0 };
+	};
+	struct MeterBank {
+		explicit MeterBank(UInt32 numChannels) : channels(numChannels) {}
+		std::vector<ChannelMeter> channels;
+	};
+
+	// Null unless metering is enabled; replaced, under mMetersMutex, when the format changes.
+	AUEpochResource<MeterBank> mMeters;
+	std::mutex mMetersMutex;
 };
 
 // ____________________________________________________________________________
@@ -422,7 +810,13 @@ public:
 
 	void SetDelegate(AUScopeDelegate* inDelegate) noexcept { mDelegate = inDelegate; }
 	void SaveState(CFMutableDataRef data) const;
-	const UInt8* RestoreState(const UInt8* state) const;
+	const UInt8* RestoreState(const UInt8* state, const UInt8* end) const;
+
+	/// Cached parameter info from the first element which has paramID (see
+	/// AUElement::CopyParameterMetadata), or nullopt.
+	[[nodiscard]] std::optional<AUElement::ParameterMetadata> CopyParameterMetadata(
+		AudioUnitParameterID paramID) const;
+	void InvalidateParameterMetadata() const;
 
 private:
 	using ElementVector = std::vector<std::unique_ptr<AUElement>>;
@@ -12,9 +12,20 @@
 #include <AudioUnitSDK/AUUtility.h>
 
 // std
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 namespace ausdk {
 /*!
@@ -137,6 +148,159 @@ protected:
 	static_assert(decltype(mHead)::is_always_lock_free);
 };
 
+// -------------------------------------------------------------------------------------------------
+/*!
+	@class	AUTaggedAtomicStack
+	@brief	Linked list LIFO stack which any number of threads may push to and pop from at once.
+
+	The head pairs the top element with a count of the changes made to it, so that a pop whose
+	view of the top has become stale fails, even if the same element is again on top (the ABA
+	problem). The pair is one 16-byte word where the processor can exchange one atomically;
+	elsewhere the count takes the top 16 bits of a 64-bit pointer, which user-space addresses
+	leave unused.
+
+	A popping thread may still read the link of an element another thread has just popped, so
+	elements must not be destroyed while the stack is in use; typically they come from a pool or
+	free list which outlives it.
+ */
+#ifdef __cpp_lib_concepts
+template <std::default_initializable T>
+#else
+template <typename T, std::enable_if_t<std::is_default_constructible_v<T>, bool> = true>
+#endif
+class AUTaggedAtomicStack {
+	struct WideHead {
+		T* node{ nullptr };
+		uintptr_t tag{ 0 };
+	};
+
+public:
+	/// Whether the head is a 16-byte pointer and count, rather than a pointer with a 16-bit count.
+	static constexpr bool kHasWideHead = std::atomic<WideHead>::is_always_lock_free;
+
+	AUTaggedAtomicStack() = default;
+
+	// Non-atomic routines, for use when initializing/deinitializing, operate NON-atomically
+	void PushNonAtomic(T* item) noexcept
+	{
+		const Head head = mHead.load(std::memory_order_relaxed);
+		item->Next() = NodeOf(head);
+		mHead.store(MakeHead(item, TagOf(head) + 1), std::memory_order_relaxed);
+	}
+
+	T* PopNonAtomic() noexcept
+	{
+		const Head head = mHead.load(std::memory_order_relaxed);
+		T* const result = NodeOf(head);
+		if (result) {
+			mHead.store(MakeHead(result->Next(), TagOf(head) + 1), std::memory_order_relaxed);
+		}
+		return result;
+	}
+
+	// Atomic routines
+	void PushAtomic(T* item) noexcept { PushMultipleAtomic(item, item); }
+
+	// Pushes entire linked list headed by item
+	void PushMultipleAtomic(T* item) noexcept
+	{
+		T* last = item;
+		while (last->Next() != nullptr) {
+			last = last->Next();
+		}
+		PushMultipleAtomic(item, last);
+	}
+
+	// Pushes the linked list from first to last, inclusive, without traversing it
+	void PushMultipleAtomic(T* first, T* last) noexcept
+	{
+		Head head = mHead.load(std::memory_order_relaxed);
+		do {
+			StoreNext(last, NodeOf(head));
+		} while (!mHead.compare_exchange_weak(head, MakeHead(first, TagOf(head) + 1),
+			std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	T* PopAtomic() noexcept
+	{
+		Head head = mHead.load(std::memory_order_acquire);
+		T* result{};
+		do {
+			if ((result = NodeOf(head)) == nullptr) {
+				break;
+			}
+		} while (!mHead.compare_exchange_weak(head, MakeHead(LoadNext(result), TagOf(head) + 1),
+			std::memory_order_acquire, std::memory_order_acquire));
+		return result;
+	}
+
+	T* PopAll() noexcept
+	{
+		Head head = mHead.load(std::memory_order_acquire);
+		T* result{};
+		do {
+			if ((result = NodeOf(head)) == nullptr) {
+				break;
+			}
+		} while (!mHead.compare_exchange_weak(head, MakeHead(nullptr, TagOf(head) + 1),
+			std::memory_order_acquire, std::memory_order_acquire));
+		return result;
+	}
+
+	[[nodiscard]] bool empty() const noexcept { return head() == nullptr; }
+
+	T* head() const noexcept { return NodeOf(mHead.load(std::memory_order_acquire)); }
+
+private:
+	static constexpr unsigned kPointerBits = 48;
+	static constexpr UInt64 kPointerMask = (UInt64{ 1 } << kPointerBits) - 1;
+
+	using Head = std::conditional_t<kHasWideHead, WideHead, UInt64>;
+
+	static Head MakeHead(T* node, uintptr_t tag) noexcept
+	{
+		if constexpr (kHasWideHead) {
+			return { node, tag };
+		} else {
+			static_assert(sizeof(T*) == sizeof(UInt64));
+			return (static_cast<UInt64>(tag) << kPointerBits) |
+				   (reinterpret_cast<UInt64>(node) & kPointerMask); // NOLINT cast
+		}
+	}
+
+	static T* NodeOf(Head head) noexcept
+	{
+		if constexpr (kHasWideHead) {
+			return head.node;
+		} else {
+			return reinterpret_cast<T*>(head & kPointerMask); // NOLINT cast
+		}
+	}
+
+	static uintptr_t TagOf(Head head) noexcept
+	{
+		if constexpr (kHasWideHead) {
+			return head.tag;
+		} else {
+			return static_cast<uintptr_t>(head >> kPointerBits);
+		}
+	}
+
+	// The links are accessed atomically because a pop may read that of an element which another
+	// thread is pushing.
+	static T* LoadNext(T* item) noexcept
+	{
+		return __atomic_load_n(&item->Next(), __ATOMIC_RELAXED);
+	}
+	static void StoreNext(T* item, T* next) noexcept
+	{
+		__atomic_store_n(&item->Next(), next, __ATOMIC_RELAXED);
+	}
+
+	std::atomic<Head> mHead{};
+	static_assert(decltype(mHead)::is_always_lock_free);
+};
+
 // -------------------------------------------------------------------------------------------------
 /*!
  @class    AUThreadSafeList
@@ -322,7 +486,8 @@ private:
 	}
 
 	void FreeNode(Node* node) { mFreeList.PushAtomic(node); }
-	static void FreeAll(AUAtomicStack<Node>& stack)
+	template <typename Stack>
+	static void FreeAll(Stack& stack)
 	{
 		Node* node{};
 		while ((node = stack.PopNonAtomic()) != nullptr) {
@@ -332,7 +497,535 @@ private:
 
 	NodeStack mActiveList;  // what's actually in the container - only accessed on one thread
 	NodeStack mPendingList; // add or remove requests - threadsafe
-	NodeStack mFreeList;    // free nodes for reuse - threadsafe
+	// free nodes for reuse - threadsafe, popped by any thread which adds or removes
+	AUTaggedAtomicStack<Node> mFreeList;
+};
+
+// -------------------------------------------------------------------------------------------------
+/*!
+ @class    AUBoundedThreadSafeList
+ @brief    A thread-safe linked list with a fixed pool of nodes and a hash index of its entries.
+
+ Like AUThreadSafeList, changes requested on any thread take effect at the next Update(), on the
+ thread which iterates the list. Here, however, Capacity nodes are allocated with the list, and
+ each value has at most one: its node carries whether the value was last added or removed, and
+ is queued for Update() until then. Requests for a value which is already queued only change
+ that, so a value may be added and removed any number of times between updates, and removing
+ a value which is neither in the list nor queued needs no node at all. Only Add can fail, when
+ Capacity other values are in the list or queued.
+
+ Requesting threads serialize among themselves, and find the node for a value through a hash of T;
+ Update() takes no lock, never allocates, and takes time proportional to the number of values
+ queued.
+ */
+template <class T, size_t Capacity, class Hash = std::hash<T>>
+class AUBoundedThreadSafeList {
+	static_assert(Capacity > 0 && Capacity < std::numeric_limits<UInt32>::max() / 2);
+
+	// Node::mState is kFree, or kOwned with either flag
+	static constexpr UInt32 kFree = 0;
+	static constexpr UInt32 kOwned = 1u << 0u;
+	static constexpr UInt32 kWanted = 1u << 1u; // last added rather than removed
+	static constexpr UInt32 kQueued = 1u << 2u; // in mPendingList
+
+public:
+	class Node {
+	public:
+		Node* mNext{ nullptr };        // in the active list
+		Node* mPrevious{ nullptr };    // in the active list
+		Node* mPendingNext{ nullptr }; // in the pending list
+		T mObject{};
+		std::atomic<UInt32> mState{ kFree };
+		bool mLinked{ false }; // only accessed on the thread which calls Update()
+
+		Node*& Next() { return mPendingNext; }
+	};
+
+	class iterator {
+	public:
+		iterator() = default;
+		explicit iterator(Node* n) : mNode(n) {}
+
+		bool operator==(const iterator& other) const { return this->mNode == other.mNode; }
+
+		T& operator*() const { return mNode->mObject; }
+
+		iterator& operator++()
+		{
+			mNode = mNode->mNext;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator tmp = *this;
+			mNode = mNode->mNext;
+			return tmp;
+		}
+
+		using iterator_category = std::forward_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = T;
+		using reference = T&;
+		using pointer = T*;
+
+	private:
+		Node* mNode{ nullptr };
+	};
+
+	AUBoundedThreadSafeList() noexcept { mIndex.fill(kNoNode); }
+
+	AUBoundedThreadSafeList(const AUBoundedThreadSafeList&) = delete;
+	AUBoundedThreadSafeList(AUBoundedThreadSafeList&&) = delete;
+	AUBoundedThreadSafeList& operator=(const AUBoundedThreadSafeList&) = delete;
+	AUBoundedThreadSafeList& operator=(AUBoundedThreadSafeList&&) = delete;
+
+	// These may be called on any thread but the one which calls Update()
+	bool Add(const T& obj) noexcept
+	{
+		const std::lock_guard lock{ mRequestMutex };
+		if (Node* const node = Find(obj); node != nullptr && Request(*node, true)) {
+			return true;
+		}
+		Node* const node = Claim(obj);
+		if (node == nullptr) {
+			return false;
+		}
+		Request(*node, true);
+		return true;
+	}
+
+	void Remove(const T& obj) noexcept
+	{
+		const std::lock_guard lock{ mRequestMutex };
+		if (Node* const node = Find(obj)) {
+			// fails only if Update() has just freed the node, and so removed the value
+			Request(*node, false);
+		}
+	}
+
+	void Clear() noexcept
+	{
+		const std::lock_guard lock{ mRequestMutex };
+		for (auto& node : mNodes) {
+			Request(node, false);
+		}
+	}
+
+	// These must be called from only one thread
+	void Update() noexcept
+	{
+		// reverse the requests so that values are linked in the order they were first queued
+		Node* node = mPendingList.PopAllReversed();
+		while (node != nullptr) {
+			// read before clearing kQueued, after which a request may queue the node again
+			Node* const next = node->mPendingNext;
+			const UInt32 state = node->mState.fetch_and(~kQueued, std::memory_order_acq_rel);
+			if ((state & kWanted) != 0) {
+				if (!node->mLinked) {
+					Link(node);
+				}
+			} else {
+				if (node->mLinked) {
+					Unlink(node);
+				}
+				// unless a request has changed it meanwhile, the node is no longer needed
+				UInt32 expected = kOwned;
+				node->mState.compare_exchange_strong(
+					expected, kFree, std::memory_order_release, std::memory_order_relaxed);
+			}
+			node = next;
+		}
+	}
+
+	iterator begin() const noexcept { return iterator(mHead); }
+	iterator end() const noexcept { return iterator(nullptr); }
+
+private:
+	static constexpr UInt32 kNoNode = std::numeric_limits<UInt32>::max();
+	static constexpr size_t kNoSlot = std::numeric_limits<size_t>::max();
+	// at most half full, so that probe sequences stay short
+	static constexpr size_t kIndexSize = std::bit_ceil(Capacity * 2);
+	static constexpr int kIndexBits = std::countr_zero(kIndexSize);
+
+	// Sets whether the node's value is wanted, and queues the node unless it already is; fails if
+	// Update() has freed the node.
+	bool Request(Node& node, bool wanted) noexcept
+	{
+		UInt32 state = node.mState.load(std::memory_order_relaxed);
+		UInt32 newState{};
+		// acquires Update()'s clearing of kQueued, which follows its last read of mPendingNext
+		do {
+			if (state == kFree) {
+				return false;
+			}
+			newState = (wanted ? (state | kWanted) : (state & ~kWanted)) | kQueued;
+		} while (!node.mState.compare_exchange_weak(
+			state, newState, std::memory_order_acq_rel, std::memory_order_relaxed));
+		if ((state & kQueued) == 0) {
+			mPendingList.PushAtomic(&node);
+		}
+		return true;
+	}
+
+	// The index entry of a node stays until the node is claimed for another value, or until its
+	// value is looked up after Update() has freed it.
+	Node* Find(const T& obj) noexcept
+	{
+		const size_t slot = FindSlot(obj);
+		if (slot == kNoSlot) {
+			return nullptr;
+		}
+		Node* const node = &mNodes[mIndex[slot]];
+		if (node->mState.load(std::memory_order_acquire) == kFree) {
+			Erase(slot);
+			return nullptr;
+		}
+		return node;
+	}
+
+	// Takes a free node for a value which has none.
+	Node* Claim(const T& obj) noexcept
+	{
+		for (auto& node : mNodes) {
+			// only Update() frees nodes, and only this thread, holding mRequestMutex, takes them
+			if (node.mState.load(std::memory_order_acquire) != kFree) {
+				continue;
+			}
+			const auto index = static_cast<UInt32>(&node - mNodes.data());
+			if (const size_t slot = FindSlot(node.mObject);
+				slot != kNoSlot && mIndex[slot] == index) {
+				Erase(slot);
+			}
+			if (const size_t slot = FindSlot(obj); slot != kNoSlot) {
+				Erase(slot); // that of another node, freed since
+			}
+			node.mObject = obj;
+			node.mState.store(kOwned, std::memory_order_relaxed);
+
+			size_t slot = HomeSlot(obj);
+			while (mIndex[slot] != kNoNode) {
+				slot = (slot + 1) % kIndexSize;
+			}
+			mIndex[slot] = index;
+			return &node;
+		}
+		return nullptr;
+	}
+
+	[[nodiscard]] static size_t HomeSlot(const T& obj) noexcept
+	{
+		constexpr UInt64 kMultiplier = 0x9E3779B97F4A7C15ull; // golden ratio
+		return static_cast<size_t>(
+			(static_cast<UInt64>(Hash{}(obj)) * kMultiplier) >> (64u - kIndexBits));
+	}
+
+	[[nodiscard]] size_t FindSlot(const T& obj) const noexcept
+	{
+		for (size_t slot = HomeSlot(obj);; slot = (slot + 1) % kIndexSize) {
+			const UInt32 index = mIndex[slot];
+			if (index == kNoNode) {
+				return kNoSlot;
+			}
+			if (mNodes[index].mObject == obj) {
+				return slot;
+			}
+		}
+	}
+
+	// Empties an index slot, moving back later entries of its probe sequence into the hole
+	// rather than leaving a tombstone.
+	void Erase(size_t hole) noexcept
+	{
+		for (size_t slot = (hole + 1) % kIndexSize; mIndex[slot] != kNoNode;
+			 slot = (slot + 1) % kIndexSize) {
+			const size_t home = HomeSlot(mNodes[mIndex[slot]].mObject);
+			if ((slot - home) % kIndexSize >= (slot - hole) % kIndexSize) {
+				mIndex[hole] = mIndex[slot];
+				hole = slot;
+			}
+		}
+		mIndex[hole] = kNoNode;
+	}
+
+	// link the node in at the end of the active list
+	void Link(Node* node) noexcept
+	{
+		node->mNext = nullptr;
+		node->mPrevious = mTail;
+		if (mTail != nullptr) {
+			mTail->mNext = node;
+		} else {
+			mHead = node;
+		}
+		mTail = node;
+		node->mLinked = true;
+	}
+
+	void Unlink(Node* node) noexcept
+	{
+		(node->mPrevious != nullptr ? node->mPrevious->mNext : mHead) = node->mNext;
+		(node->mNext != nullptr ? node->mNext->mPrevious : mTail) = node->mPrevious;
+		node->mLinked = false;
+	}
+
+	std::array<Node, Capacity> mNodes;
+	AUAtomicStack<Node> mPendingList; // add or remove requests - threadsafe
+
+	// only accessed by requesting threads, holding mRequestMutex
+	std::mutex mRequestMutex;
+	std::array<UInt32, kIndexSize> mIndex{}; // indices into mNodes of the owned nodes, hashed
+
+	// only accessed on the thread which calls Update()
+	Node* mHead{ nullptr };
+	Node* mTail{ nullptr };
+};
+
+// -------------------------------------------------------------------------------------------------
+/*!
+	@class	AUSPSCRingBuffer
+	@brief	Fixed-capacity FIFO of trivially copyable messages from one producer thread to one
+			consumer thread, e.g. meter values or MIDI output from the render thread.
+
+	Push and Pop are wait-free and never allocate. The producer's and consumer's indices are on
+	separate cache lines, and each side caches the other's index, reloading it only when the ring
+	appears full or empty.
+ */
+template <typename T, size_t Capacity>
+	requires std::is_trivially_copyable_v<T> && (std::has_single_bit(Capacity))
+class AUSPSCRingBuffer {
+public:
+	AUSPSCRingBuffer() = default;
+
+	AUSPSCRingBuffer(const AUSPSCRingBuffer&) = delete;
+	AUSPSCRingBuffer(AUSPSCRingBuffer&&) = delete;
+	AUSPSCRingBuffer& operator=(const AUSPSCRingBuffer&) = delete;
+	AUSPSCRingBuffer& operator=(AUSPSCRingBuffer&&) = delete;
+
+	// Producer thread only. Returns false if the ring is full.
+	bool Push(const T& message) noexcept { return Push(std::span(&message, 1)) == 1; }
+
+	// Producer thread only. Pushes as many of the messages as fit, returning their number.
+	size_t Push(std::span<const T> messages) noexcept
+	{
+		const size_t write = mWrite.load(std::memory_order_relaxed);
+		if (Capacity - (write - mCachedRead) < messages.size()) {
+			mCachedRead = mRead.load(std::memory_order_acquire);
+		}
+		const size_t count = std::min(messages.size(), Capacity - (write - mCachedRead));
+		for (size_t i = 0; i < count; ++i) {
+			mMessages[(write + i) % Capacity] = messages[i];
+		}
+		mWrite.store(write + count, std::memory_order_release);
+		return count;
+	}
+
+	// Consumer thread only. Returns false if the ring is empty.
+	bool Pop(T& message) noexcept { return Pop(std::span(&message, 1)) == 1; }
+
+	// Consumer thread only. Pops as many messages as are available and fit, returning their
+	// number.
+	size_t Pop(std::span<T> messages) noexcept
+	{
+		const size_t read = mRead.load(std::memory_order_relaxed);
+		if (mCachedWrite - read < messages.size()) {
+			mCachedWrite = mWrite.load(std::memory_order_acquire);
+		}
+		const size_t count = std::min(messages.size(), mCachedWrite - read);
+		for (size_t i = 0; i < count; ++i) {
+			messages[i] = mMessages[(read + i) % Capacity];
+		}
+		mRead.store(read + count, std::memory_order_release);
+		return count;
+	}
+
+	// The number of messages in the ring; exact only on the producer or consumer thread, when
+	// the other is idle.
+	[[nodiscard]] size_t Size() const noexcept
+	{
+		return mWrite.load(std::memory_order_acquire) - mRead.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+	// written by the producer
+	[[maybe_unused]] AUCacheLinePadding mWritePadding{};
+	std::atomic<size_t> mWrite{ 0 };
+	size_t mCachedRead{ 0 };
+
+	// written by the consumer
+	[[maybe_unused]] AUCacheLinePadding mReadPadding{};
+	std::atomic<size_t> mRead{ 0 };
+	size_t mCachedWrite{ 0 };
+
+	[[maybe_unused]] AUCacheLinePadding mMessagesPadding{};
+	std::array<T, Capacity> mMessages{};
+};
+
+// -------------------------------------------------------------------------------------------------
+/*!
+	@class	AUMPSCRingBuffer
+	@brief	Fixed-capacity FIFO of trivially copyable messages from any number of producer threads
+			to one consumer thread, e.g. commands from control threads to the render thread.
+
+	Producers claim space with a compare-and-swap on the write index, so Push is lock-free rather
+	than wait-free; Pop is wait-free. Each slot carries the index it was last written for, so the
+	consumer stops at the first message whose producer has not yet finished writing it. Messages
+	pushed together by one Push are consecutive.
+ */
+template <typename T, size_t Capacity>
+	requires std::is_trivially_copyable_v<T> && (std::has_single_bit(Capacity))
+class AUMPSCRingBuffer {
+public:
+	AUMPSCRingBuffer() = default;
+
+	AUMPSCRingBuffer(const AUMPSCRingBuffer&) = delete;
+	AUMPSCRingBuffer(AUMPSCRingBuffer&&) = delete;
+	AUMPSCRingBuffer& operator=(const AUMPSCRingBuffer&) = delete;
+	AUMPSCRingBuffer& operator=(AUMPSCRingBuffer&&) = delete;
+
+	// Any thread. Returns false if the ring is full.
+	bool Push(const T& message) noexcept { return Push(std::span(&message, 1)) == 1; }
+
+	// Any thread. Pushes as many of the messages as fit, returning their number.
+	size_t Push(std::span<const T> messages) noexcept
+	{
+		size_t write = mWrite.load(std::memory_order_relaxed);
+		size_t count{};
+		do {
+			const size_t free = Capacity - (write - mRead.load(std::memory_order_acquire));
+			count = std::min(messages.size(), free);
+			if (count == 0) {
+				return 0;
+			}
+		} while (!mWrite.compare_exchange_weak(
+			write, write + count, std::memory_order_relaxed, std::memory_order_relaxed));
+
+		for (size_t i = 0; i < count; ++i) {
+			auto& slot = mSlots[(write + i) % Capacity];
+			slot.message = messages[i];
+			slot.written.store(write + i + 1, std::memory_order_release);
+		}
+		return count;
+	}
+
+	// Consumer thread only. Returns false if the ring is empty.
+	bool Pop(T& message) noexcept { return Pop(std::span(&message, 1)) == 1; }
+
+	// Consumer thread only. Pops as many messages as are available and fit, returning their
+	// number.
+	size_t Pop(std::span<T> messages) noexcept
+	{
+		const size_t read = mRead.load(std::memory_order_relaxed);
+		size_t count = 0;
+		for (; count < messages.size(); ++count) {
+			const auto& slot = mSlots[(read + count) % Capacity];
+			if (slot.written.load(std::memory_order_acquire) != read + count + 1) {
+				break;
+			}
+			messages[count] = slot.message;
+		}
+		mRead.store(read + count, std::memory_order_release);
+		return count;
+	}
+
+	// The number of messages claimed by producers and not yet popped; approximate.
+	[[nodiscard]] size_t Size() const noexcept
+	{
+		return mWrite.load(std::memory_order_acquire) - mRead.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+	struct Slot {
+		std::atomic<size_t> written{ 0 }; // 1 + the write index of the message, once written
+		T message{};
+	};
+
+	[[maybe_unused]] AUCacheLinePadding mWritePadding{};
+	std::atomic<size_t> mWrite{ 0 }; // written by the producers
+	[[maybe_unused]] AUCacheLinePadding mReadPadding{};
+	std::atomic<size_t> mRead{ 0 }; // written by the consumer
+	[[maybe_unused]] AUCacheLinePadding mSlotsPadding{};
+	std::array<Slot, Capacity> mSlots{};
+};
+
+// -------------------------------------------------------------------------------------------------
+/*!
+	@class	AUTripleBuffer
+	@brief	Publishes snapshots, such as spectra or meter histories, from one writer thread to
+			readers which want only the newest.
+
+	Of three buffers, the writer fills one, the readers read another, and the third holds the
+	newest published snapshot. Publish and the readers' fetch each exchange their buffer with the
+	third, in one atomic operation, so the writer never waits, never allocates, and never
+	overwrites a snapshot being read; snapshots published between two reads are skipped. Readers
+	take a mutex among themselves, which the writer never takes.
+ */
+template <std::default_initializable T>
+class AUTripleBuffer {
+public:
+	AUTripleBuffer() = default;
+
+	AUTripleBuffer(const AUTripleBuffer&) = delete;
+	AUTripleBuffer(AUTripleBuffer&&) = delete;
+	AUTripleBuffer& operator=(const AUTripleBuffer&) = delete;
+	AUTripleBuffer& operator=(AUTripleBuffer&&) = delete;
+
+	// Writer thread only: the buffer to fill before Publish(), holding an older snapshot.
+	T& WriteBuffer() noexcept { return mBuffers[mWriteIndex].value; }
+
+	// Writer thread only. Wait-free.
+	void Publish() noexcept
+	{
+		mWriteIndex =
+			mMiddle.exchange(mWriteIndex | kFreshFlag, std::memory_order_acq_rel) & kIndexMask;
+	}
+
+	void Publish(const T& snapshot) noexcept(std::is_nothrow_copy_assignable_v<T>)
+	{
+		WriteBuffer() = snapshot;
+		Publish();
+	}
+
+	// Any non-realtime thread: calls `f` with the newest snapshot, or a default-constructed T
+	// if none has been published, returning whether it is new since the previous read.
+	template <typename F>
+		requires std::invocable<F&, const T&>
+	bool Read(F&& f)
+	{
+		const std::lock_guard lock{ mReaderMutex };
+		const bool fresh = (mMiddle.load(std::memory_order_relaxed) & kFreshFlag) != 0;
+		if (fresh) {
+			mReadIndex = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel) & kIndexMask;
+		}
+		f(std::as_const(mBuffers[mReadIndex].value));
+		return fresh;
+	}
+
+	bool Read(T& out)
+	{
+		return Read([&out](const T& snapshot) { out = snapshot; });
+	}
+
+private:
+	static constexpr UInt32 kIndexMask = 3;
+	static constexpr UInt32 kFreshFlag = 4; // the middle buffer has not been read
+
+	struct Buffer {
+		T value{};
+		[[maybe_unused]] AUCacheLinePadding padding{}; // from the next buffer, or mMiddle
+	};
+
+	[[maybe_unused]] AUCacheLinePadding mBuffersPadding{};
+	std::array<Buffer, 3> mBuffers{};
+	std::atomic<UInt32> mMiddle{ 1 };
+	UInt32 mWriteIndex{ 0 };
+	[[maybe_unused]] AUCacheLinePadding mReadIndexPadding{};
+	UInt32 mReadIndex{ 2 }; // guarded by mReaderMutex
+	std::mutex mReaderMutex;
 };
 
 } // namespace ausdk
@@ -17,8 +17,10 @@
 #endif
 
 // std
+#include <array>
 #include <bitset>
 #include <climits>
+#include <cstddef>
 #include <cstring>
 #include <memory>
 #include <mutex>
@@ -165,6 +167,17 @@ private:
 	AUMutex* mMutex;
 };
 
+// -------------------------------------------------------------------------------------------------
+
+/// Granularity used to keep independently written data on separate cache lines (128 bytes on
+/// Apple silicon, which also covers adjacent-line prefetch on Intel).
+inline constexpr size_t kCacheLineSize = 128;
+
+/// Filler which keeps the members on either side of it on separate cache lines. Unlike alignas,
+/// it does not over-align the enclosing type, which matters for anything an Audio Unit holds:
+/// AudioComponentPlugInInstance constructs units in storage which is only 16-byte aligned.
+using AUCacheLinePadding = std::array<std::byte, kCacheLineSize>;
+
 // -------------------------------------------------------------------------------------------------
 #pragma mark -
 #pragma mark ASBD
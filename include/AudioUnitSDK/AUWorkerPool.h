@@ -0,0 +1,152 @@
+/*!
+	@file		AudioUnitSDK/AUWorkerPool.h
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#ifndef AudioUnitSDK_AUWorkerPool_h
+#define AudioUnitSDK_AUWorkerPool_h
+
+// module
+// clang-format off
+#include <AudioUnitSDK/AUConfig.h> // must come first
+// clang-format on
+#include <AudioUnitSDK/AUUtility.h>
+
+// OS
+#if defined(__APPLE__)
+#include <mach/semaphore.h>
+#endif
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#if !defined(__APPLE__)
+#include <semaphore>
+#endif
+#include <thread>
+#include <vector>
+
+namespace ausdk {
+
+// ____________________________________________________________________________
+//
+/*!
+	@class	AUWorkerPool
+	@brief	A fixed set of threads which help the render thread run independent tasks, such as
+			pulling the inputs of a multi-input unit.
+
+	Run hands out the indices of a job one at a time, to the workers and to the calling thread
+	alike, and returns once every task has finished. Since the caller runs every task not yet
+	claimed itself rather than waiting for the workers to start, a job never takes longer than
+	running it serially plus the longest task a worker has already claimed; the workers only
+	ever shorten it. Jobs must not overlap, which the render thread guarantees.
+
+	The workers sleep on a semaphore between jobs, which Run signals without taking a lock. On
+	Apple platforms they use the time-constraint (real-time) scheduling policy, like the render
+	thread, so that the render thread never waits for a task on a thread of lower priority.
+	Once only tasks running on workers remain, Run spins for them for at most kMaxSpins pauses,
+	and then sleeps until the last of them signals that it has finished.
+*/
+class AUWorkerPool {
+public:
+	using Task = void (*)(void* context, size_t index);
+
+	/// Starts `threadCount` workers, scheduled for a render cycle every `renderPeriod` (see
+	/// kDefaultRenderPeriod). Not realtime-safe.
+	explicit AUWorkerPool(
+		UInt32 threadCount, std::chrono::nanoseconds renderPeriod = kDefaultRenderPeriod);
+
+	/// Stops and joins the workers; no job may be running. Not realtime-safe.
+	~AUWorkerPool();
+
+	AUWorkerPool(const AUWorkerPool&) = delete;
+	AUWorkerPool(AUWorkerPool&&) = delete;
+	AUWorkerPool& operator=(const AUWorkerPool&) = delete;
+	AUWorkerPool& operator=(AUWorkerPool&&) = delete;
+
+	[[nodiscard]] UInt32 ThreadCount() const noexcept
+	{
+		return static_cast<UInt32>(mThreads.size());
+	}
+
+	/// The largest number of tasks in one job.
+	static constexpr size_t kMaxTasks = (size_t{ 1 } << 24) - 1;
+
+	/// 1024 frames at 44.1 kHz.
+	static constexpr std::chrono::nanoseconds kDefaultRenderPeriod{ 23'219'955 };
+
+	/// How many times Run pauses the processor while waiting for the workers' last tasks before
+	/// it sleeps instead: some microseconds, depending on the processor.
+	static constexpr UInt32 kMaxSpins = 1024;
+
+	/// Calls task(context, index) for each index in [0, count) and returns when all have
+	/// finished; count must not exceed kMaxTasks. The task must not throw. Realtime-safe:
+	/// waking the workers takes no lock, and once the spin is spent the caller sleeps only on
+	/// the workers' own tasks. Returns false if it had to sleep.
+	bool Run(size_t count, Task task, void* context) noexcept;
+
+	/// Calls f(index) for each index in [0, count).
+	template <typename F>
+	bool Run(size_t count, F& f) noexcept
+	{
+		return Run(
+			count, [](void* context, size_t index) { (*static_cast<F*>(context))(index); }, &f);
+	}
+
+private:
+	// Counts signals, which any thread may send without taking a lock.
+	class Semaphore {
+	public:
+		Semaphore();
+		~Semaphore();
+
+		Semaphore(const Semaphore&) = delete;
+		Semaphore(Semaphore&&) = delete;
+		Semaphore& operator=(const Semaphore&) = delete;
+		Semaphore& operator=(Semaphore&&) = delete;
+
+		void Signal() noexcept;
+		void Wait() noexcept;
+
+	private:
+#if defined(__APPLE__)
+		semaphore_t mSemaphore{};
+#else
+		std::counting_semaphore<> mSemaphore{ 0 };
+#endif
+	};
+
+	static constexpr unsigned kIndexBits = 24;
+	static constexpr unsigned kCountShift = kIndexBits;
+	static constexpr unsigned kGenerationShift = 2 * kIndexBits;
+	static constexpr UInt64 kIndexMask = kMaxTasks;
+
+	// Claims and runs one task of the current job, returning false if none is left.
+	bool RunOne() noexcept;
+	// Sleeps until the tasks running on workers have finished.
+	void WaitForWorkers() noexcept;
+	void WorkerLoop(std::chrono::nanoseconds renderPeriod) noexcept;
+
+	// the job's generation, task count and next unclaimed index, in one word so that a worker
+	// waking late can never claim an index against the count of a different job
+	[[maybe_unused]] AUCacheLinePadding mJobPadding{};
+	std::atomic<UInt64> mJob{ 0 };
+	Task mTask{ nullptr };
+	void* mContext{ nullptr };
+
+	// written as each task finishes
+	[[maybe_unused]] AUCacheLinePadding mPendingPadding{};
+	std::atomic<size_t> mPending{ 0 };
+	std::atomic<bool> mCallerWaiting{ false }; // Run is sleeping, or about to, on mFinished
+
+	[[maybe_unused]] AUCacheLinePadding mWakeupPadding{};
+	std::atomic<size_t> mWakeups{ 0 }; // signals of mWakeup not yet taken, at most one a worker
+	std::atomic<bool> mStopping{ false };
+	Semaphore mWakeup;
+	Semaphore mFinished;
+	std::vector<std::thread> mThreads;
+};
+
+} // namespace ausdk
+
+#endif // AudioUnitSDK_AUWorkerPool_h
@@ -9,18 +9,25 @@
 #include <AudioUnitSDK/AUConfig.h> // must come first
 // clang-format on
 #include <AudioUnitSDK/AUBase.h>
+#include <AudioUnitSDK/AUBinaryState.h>
 #include <AudioUnitSDK/AUBuffer.h>
 #include <AudioUnitSDK/AUEffectBase.h>
+#include <AudioUnitSDK/AUEpoch.h>
 #include <AudioUnitSDK/AUInputElement.h>
 #if AUSDK_HAVE_MIDI
 #include <AudioUnitSDK/AUMIDIBase.h>
 #include <AudioUnitSDK/AUMIDIEffectBase.h>
 #endif // AUSDK_HAVE_MIDI
 #include <AudioUnitSDK/AUOutputElement.h>
+#include <AudioUnitSDK/AUParameterTable.h>
 #include <AudioUnitSDK/AUPlugInDispatch.h>
+#include <AudioUnitSDK/AUPresetBank.h>
+#include <AudioUnitSDK/AUPropertyChangeQueue.h>
+#include <AudioUnitSDK/AUPropertyRegistry.h>
 #include <AudioUnitSDK/AUScopeElement.h>
 #include <AudioUnitSDK/AUSilentTimeout.h>
 #include <AudioUnitSDK/AUUtility.h>
+#include <AudioUnitSDK/AUWorkerPool.h>
 #include <AudioUnitSDK/ComponentBase.h>
 #if AUSDK_HAVE_MUSIC_DEVICE
 #include <AudioUnitSDK/MusicDeviceBase.h>
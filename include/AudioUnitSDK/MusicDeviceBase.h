@@ -47,12 +47,7 @@ public:
 	}
 #endif
 
-	OSStatus GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable) override;
-	OSStatus GetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, void* outData) override;
-	OSStatus SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-		AudioUnitElement inElement, const void* inData, UInt32 inDataSize) override;
+	[[nodiscard]] const AUPropertyRegistry& GetPropertyRegistry() const override;
 	OSStatus HandleNoteOn(
 		UInt8 inChannel, UInt8 inNoteNumber, UInt8 inVelocity, UInt32 inStartFrame) override;
 	OSStatus HandleNoteOff(
@@ -16,8 +16,10 @@
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <span>
+#include <thread>
 
 namespace ausdk {
 
@@ -95,6 +97,11 @@ AUBase::~AUBase()
 	if (mCurrentPreset.presetName != nullptr) {
 		CFRelease(mCurrentPreset.presetName);
 	}
+	delete mPublishedParameters.exchange(nullptr, std::memory_order_acquire); // NOLINT owning
+	delete mActiveMorph;                                                      // NOLINT owning
+	delete mUnappliedSnapshot;                                                // NOLINT owning
+	ReclaimParameterSnapshots();
+	delete mPublishedPropertyListeners.load(std::memory_order_acquire); // NOLINT owning
 }
 
 //_____________________________________________________________________________
@@ -114,6 +121,8 @@ void AUBase::PreDestructorInternal()
 {
 	// this is called from the ComponentBase dispatcher, which doesn't know anything about our
 	// (optional) lock
+	StopPropertyChangeDispatcher(); // before the lock, which its listeners may take
+	mRenderEpochs.StopReclaimer();
 	const AUEntryGuard guard(mAUMutex);
 	DoCleanup();
 }
@@ -216,12 +225,32 @@ OSStatus AUBase::Initialize() { return noErr; }
 //
 void AUBase::DoCleanup()
 {
+	// Parameters still waiting for a render cycle are applied now, as rendering has stopped, and
+	// a timed morph jumps to its end.
+	if (const std::unique_ptr<AUParameterSnapshot> morph{ std::exchange(mActiveMorph, nullptr) };
+		morph && morph->mMorphFrames != 0) {
+		morph->Apply();
+	}
+	if (const std::unique_ptr<AUParameterSnapshot> unapplied{ std::exchange(
+			mUnappliedSnapshot, nullptr) }) {
+		while (!unapplied->TryApply()) { // only the runs not applied yet
+			std::this_thread::yield();
+		}
+	}
+	if (const std::unique_ptr<AUParameterSnapshot> pending{
+			mPublishedParameters.exchange(nullptr, std::memory_order_acquire) }) {
+		pending->Apply();
+	}
+	ReclaimParameterSnapshots();
+	mRenderEpochs.Reclaim();
+
 	if (mInitialized) {
 		Cleanup();
 	}
 
 	DeallocateIOBuffers();
 	ResetRenderTime();
+	InvalidateParameterMetadata();
 
 	mInitialized = false;
 	mHasBegunInitializing = false;
@@ -437,6 +466,42 @@ OSStatus AUBase::DispatchGetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScop
 		outWritable = true;
 		break;
 
+	case kAUSDKProperty_ParameterTransaction:
+		// variable-size: any whole number of entries may be set
+		outDataSize = sizeof(AUParameterIDValue);
+		outWritable = true;
+		break;
+
+	case kAUSDKProperty_SetParameterValues:
+		AUSDK_Require(inScope == kAudioUnitScope_Global, kAudioUnitErr_InvalidScope);
+		// variable-size: any whole number of entries may be set
+		outDataSize = sizeof(AUParameterAddressValue);
+		outWritable = true;
+		break;
+
+	case kAUSDKProperty_GetParameterValues:
+		AUSDK_Require(inScope == kAudioUnitScope_Global, kAudioUnitErr_InvalidScope);
+		outDataSize = sizeof(AUParameterValueList);
+		outWritable = false;
+		break;
+
+	case kAUSDKProperty_BinaryState:
+	case kAUSDKProperty_DeltaState:
+		AUSDK_Require(inScope == kAudioUnitScope_Global, kAudioUnitErr_InvalidScope);
+		outDataSize = sizeof(CFDataRef);
+		outWritable = true;
+		break;
+
+	case kAUSDKProperty_Meters: {
+		AUSDK_Require(inScope == kAudioUnitScope_Input || inScope == kAudioUnitScope_Output,
+			kAudioUnitErr_InvalidScope);
+		const auto& element = IOElement(inScope, inElement);
+		AUSDK_Require(element.IsMeteringEnabled(), kAudioUnitErr_PropertyNotInUse);
+		outDataSize = element.NumberChannels() * static_cast<UInt32>(sizeof(AUChannelMeterValues));
+		outWritable = false;
+		break;
+	}
+
 	default:
 		result = GetPropertyInfo(inID, inScope, inElement, outDataSize, outWritable);
 		validateElement = false;
@@ -485,7 +550,7 @@ OSStatus AUBase::DispatchGetProperty(
 
 	case kAudioUnitProperty_ParameterInfo: {
 		AudioUnitParameterInfo parameterInfo{};
-		result = GetParameterInfo(inScope, inElement, parameterInfo);
+		result = GetCachedParameterInfo(inScope, inElement, parameterInfo);
 		Serialize(parameterInfo, outData);
 		break;
 	}
@@ -648,6 +713,37 @@ OSStatus AUBase::DispatchGetProperty(
 		break;
 	}
 
+	case kAUSDKProperty_GetParameterValues: {
+		// the caller passes in the list to be filled
+		const auto list = Deserialize<AUParameterValueList>(outData);
+		AUSDK_Require(list.mValues != nullptr || list.mNumberValues == 0, kAudio_ParamError);
+		result = GetParameterValues(std::span(list.mValues, list.mNumberValues));
+		break;
+	}
+
+	case kAUSDKProperty_BinaryState: {
+		CFDataRef data = nullptr;
+		result = SaveBinaryState(&data);
+		Serialize(data, outData);
+		break;
+	}
+
+	case kAUSDKProperty_DeltaState: {
+		CFDataRef data = nullptr;
+		result = SaveDeltaState(&data);
+		Serialize(data, outData);
+		break;
+	}
+
+	case kAUSDKProperty_Meters: {
+		auto& element = IOElement(inScope, inElement);
+		AUSDK_Require(element.IsMeteringEnabled(), kAudioUnitErr_PropertyNotInUse);
+		std::vector<AUChannelMeterValues> values(element.NumberChannels());
+		element.ReadMeters(values);
+		Serialize(std::span(values), outData);
+		break;
+	}
+
 	default:
 		result = GetProperty(inID, inScope, inElement, outData);
 		break;
@@ -843,6 +939,30 @@ OSStatus AUBase::DispatchSetProperty(AudioUnitPropertyID inID, AudioUnitScope in
 		PropertyChanged(inID, inScope, inElement);
 		break;
 
+	case kAUSDKProperty_ParameterTransaction: {
+		AUSDK_Require(
+			inDataSize % sizeof(AUParameterIDValue) == 0, kAudioUnitErr_InvalidPropertyValue);
+		const auto values = DeserializeArray<AUParameterIDValue>(inData, inDataSize);
+		result = SetParameters(inScope, inElement, values);
+		break;
+	}
+
+	case kAUSDKProperty_SetParameterValues: {
+		AUSDK_Require(inScope == kAudioUnitScope_Global, kAudioUnitErr_InvalidScope);
+		AUSDK_Require(inDataSize % sizeof(AUParameterAddressValue) == 0,
+			kAudioUnitErr_InvalidPropertyValue);
+		const auto values = DeserializeArray<AUParameterAddressValue>(inData, inDataSize);
+		result = SetParameterValues(values);
+		break;
+	}
+
+	case kAUSDKProperty_BinaryState:
+	case kAUSDKProperty_DeltaState:
+		AUSDK_Require(inDataSize == sizeof(CFDataRef), kAudioUnitErr_InvalidPropertyValue);
+		AUSDK_Require(inScope == kAudioUnitScope_Global, kAudioUnitErr_InvalidScope);
+		result = RestoreBinaryState(Deserialize<CFDataRef>(inData));
+		break;
+
 	default:
 		result = SetProperty(inID, inScope, inElement, inData, inDataSize);
 		if (result == noErr) {
@@ -901,28 +1021,38 @@ OSStatus AUBase::DispatchRemovePropertyValue(
 
 //_____________________________________________________________________________
 //
-OSStatus AUBase::GetPropertyInfo(AudioUnitPropertyID /*inID*/, AudioUnitScope /*inScope*/,
-	AudioUnitElement /*inElement*/, UInt32& /*outDataSize*/, bool& /*outWritable*/)
+OSStatus AUBase::GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
+	AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable)
 {
-	return kAudioUnitErr_InvalidProperty;
+	return GetPropertyRegistry().GetPropertyInfo(
+		*this, inID, inScope, inElement, outDataSize, outWritable);
 }
 
 
 //_____________________________________________________________________________
 //
-OSStatus AUBase::GetProperty(AudioUnitPropertyID /*inID*/, AudioUnitScope /*inScope*/,
-	AudioUnitElement /*inElement*/, void* /*outData*/)
+OSStatus AUBase::GetProperty(
+	AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement, void* outData)
 {
-	return kAudioUnitErr_InvalidProperty;
+	return GetPropertyRegistry().GetProperty(*this, inID, inScope, inElement, outData);
 }
 
 
 //_____________________________________________________________________________
 //
-OSStatus AUBase::SetProperty(AudioUnitPropertyID /*inID*/, AudioUnitScope /*inScope*/,
-	AudioUnitElement /*inElement*/, const void* /*inData*/, UInt32 /*inDataSize*/)
+OSStatus AUBase::SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
+	AudioUnitElement inElement, const void* inData, UInt32 inDataSize)
 {
-	return kAudioUnitErr_InvalidProperty;
+	return GetPropertyRegistry().SetProperty(*this, inID, inScope, inElement, inData, inDataSize);
+}
+
+
+//_____________________________________________________________________________
+//
+const AUPropertyRegistry& AUBase::GetPropertyRegistry() const
+{
+	static const AUPropertyRegistry registry;
+	return registry;
 }
 
 //_____________________________________________________________________________
@@ -942,10 +1072,15 @@ OSStatus AUBase::AddPropertyListener(
 		.propertyID = inID, .listenerProc = inProc, .listenerRefCon = inProcRefCon
 	};
 
+	const std::lock_guard lock{ mPropertyListenersMutex };
 	if (mPropertyListeners.empty()) {
 		mPropertyListeners.reserve(32); // NOLINT magic#
 	}
-	mPropertyListeners.push_back(pl);
+	// kept in order of ID, after the existing listeners to the property
+	mPropertyListeners.insert(std::ranges::upper_bound(mPropertyListeners, inID, std::less{},
+								  &PropertyListener::propertyID),
+		pl);
+	PublishPropertyListeners();
 
 	return noErr;
 }
@@ -955,23 +1090,153 @@ OSStatus AUBase::AddPropertyListener(
 OSStatus AUBase::RemovePropertyListener(AudioUnitPropertyID inID,
 	AudioUnitPropertyListenerProc inProc, void* inProcRefCon, bool refConSpecified)
 {
-	std::erase_if(mPropertyListeners, [&](auto& item) {
+	const std::lock_guard lock{ mPropertyListenersMutex };
+	const auto removed = std::erase_if(mPropertyListeners, [&](auto& item) {
 		return item.propertyID == inID && item.listenerProc == inProc &&
 			   (!refConSpecified || item.listenerRefCon == inProcRefCon);
 	});
+	if (removed != 0) {
+		PublishPropertyListeners();
+	}
 	return noErr;
 }
 
+//_____________________________________________________________________________
+//
+//	A reader counts itself before loading the copy, and the copy is replaced before the readers
+//	are checked, all sequentially consistent: so a reader which the check misses can only have
+//	loaded the new copy, and the replaced ones are not in use.
+//
+void AUBase::PublishPropertyListeners()
+{
+	auto copy = mPropertyListeners.empty()
+					? nullptr
+					: std::make_unique<PropertyListeners>(mPropertyListeners);
+	mRetiredPropertyListeners.reserve(mRetiredPropertyListeners.size() + 1);
+	std::unique_ptr<const PropertyListeners> replaced{ mPublishedPropertyListeners.exchange(
+		copy.release(), std::memory_order_seq_cst) };
+	if (replaced) {
+		mRetiredPropertyListeners.push_back(std::move(replaced));
+	}
+	if (mPropertyListenerReaders.load(std::memory_order_seq_cst) == 0) {
+		mRetiredPropertyListeners.clear();
+	}
+}
+
 //_____________________________________________________________________________
 //
 void AUBase::PropertyChanged(
 	AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement)
 {
-	for (const auto& pl : mPropertyListeners) {
-		if (pl.propertyID == inID) {
+	if (inID == kAudioUnitProperty_ParameterList || inID == kAudioUnitProperty_ParameterInfo) {
+		InvalidateParameterMetadata();
+	}
+	if (DefersPropertyChanges()) {
+		mPropertyChanges.Post({ .propertyID = inID, .scope = inScope, .element = inElement });
+		return;
+	}
+	NotifyPropertyListeners(inID, inScope, inElement);
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::NotifyPropertyListeners(
+	AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement) noexcept
+{
+	// The listeners may add and remove listeners, which never waits for this thread.
+	mPropertyListenerReaders.fetch_add(1, std::memory_order_seq_cst);
+	if (const PropertyListeners* const listeners =
+			mPublishedPropertyListeners.load(std::memory_order_seq_cst)) {
+		const auto range = std::ranges::equal_range(
+			*listeners, inID, std::less{}, &PropertyListener::propertyID);
+		for (const auto& pl : range) {
 			(pl.listenerProc)(pl.listenerRefCon, GetComponentInstance(), inID, inScope, inElement);
 		}
 	}
+	mPropertyListenerReaders.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+//_____________________________________________________________________________
+//
+size_t AUBase::DispatchPropertyChanges()
+{
+	return mPropertyChanges.Drain([this](const AUPropertyChangeQueue::Change& change) {
+		NotifyPropertyListeners(change.propertyID, change.scope, change.element);
+	});
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::StartPropertyChangeDispatcher(std::chrono::milliseconds interval)
+{
+	SetDefersPropertyChanges(true);
+	mPropertyChanges.StartDispatcher(interval, [this](const AUPropertyChangeQueue::Change& change) {
+		NotifyPropertyListeners(change.propertyID, change.scope, change.element);
+	});
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::StopPropertyChangeDispatcher()
+{
+	if (mPropertyChanges.IsDispatching()) {
+		mPropertyChanges.StopDispatcher();
+		SetDefersPropertyChanges(false);
+		DispatchPropertyChanges(); // posted since the dispatcher's final pass
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::SetParallelPullThreadCount(UInt32 threadCount)
+{
+	if (threadCount == 0) {
+		mPullWorkers.Publish(nullptr);
+		return;
+	}
+	// The workers are scheduled for render cycles of the current maximum slice size.
+	const Float64 sampleRate = Inputs().GetNumberOfElements() > 0
+								   ? Input(0).GetStreamFormat().mSampleRate
+								   : kAUDefaultSampleRate;
+	const auto renderPeriod = sampleRate > 0.
+								  ? std::chrono::nanoseconds{ static_cast<SInt64>(
+										1.0e9 * GetMaxFramesPerSlice() / sampleRate) } // NOLINT
+								  : AUWorkerPool::kDefaultRenderPeriod;
+	mPullWorkers.Publish(std::make_unique<AUWorkerPool>(threadCount, renderPeriod));
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUBase::PullInputs(std::span<const AudioUnitElement> inElements,
+	AudioUnitRenderActionFlags inActionFlags, const AudioTimeStamp& inTimeStamp, UInt32 nFrames,
+	std::span<AudioUnitRenderActionFlags> outActionFlags, std::span<OSStatus> outResults)
+{
+	AUSDK_Require(outActionFlags.size() >= inElements.size() &&
+					  outResults.size() >= inElements.size() &&
+					  inElements.size() <= AUWorkerPool::kMaxTasks,
+		kAudio_ParamError);
+
+	auto pull = [&](size_t index) noexcept {
+		OSStatus result = noErr;
+		outActionFlags[index] = inActionFlags;
+		try {
+			result = Input(inElements[index])
+						 .PullInput(outActionFlags[index], inTimeStamp, inElements[index], nFrames);
+		}
+		AUSDK_Catch(result)
+		outResults[index] = result;
+	};
+	if (AUWorkerPool* const workers = mPullWorkers.Get()) {
+		workers->Run(inElements.size(), pull);
+	} else {
+		for (size_t index = 0; index < inElements.size(); ++index) {
+			pull(index);
+		}
+	}
+
+	const auto firstError = std::ranges::find_if(
+		outResults.first(inElements.size()), [](OSStatus result) { return result != noErr; });
+	return firstError != outResults.first(inElements.size()).end() ? *firstError : noErr;
 }
 
 //_____________________________________________________________________________
@@ -983,8 +1248,8 @@ OSStatus AUBase::SetRenderNotification(AURenderCallback inProc, void* inRefCon)
 	}
 
 	mRenderCallbacksTouched = true;
-	mRenderCallbacks.Add(RenderCallback(inProc, inRefCon));
 	// this will do nothing if it's already in the list
+	AUSDK_Require(mRenderCallbacks.Add(RenderCallback(inProc, inRefCon)), kAudio_MemFullError);
 	return noErr;
 }
 
@@ -996,16 +1261,65 @@ OSStatus AUBase::RemoveRenderNotification(AURenderCallback inProc, void* inRefCo
 	return noErr; // error?
 }
 
+//_____________________________________________________________________________
+//
+//	The element of the run which GetParameters() is reading on this thread, if any, so that the
+//	base GetParameter() does not look it up again for each value.
+//
+struct ParameterReadRun {
+	const AUBase* unit;
+	AudioUnitScope scope;
+	AudioUnitElement element;
+	const AUElement* elem;
+};
+static thread_local const ParameterReadRun* sParameterReadRun = nullptr; // NOLINT
+
 //_____________________________________________________________________________
 //
 OSStatus AUBase::GetParameter(AudioUnitParameterID inID, AudioUnitScope inScope,
 	AudioUnitElement inElement, AudioUnitParameterValue& outValue)
 {
-	const auto& elem = Element(inScope, inElement);
+	const ParameterReadRun* const run = sParameterReadRun;
+	const auto& elem =
+		(run != nullptr && run->unit == this && run->scope == inScope && run->element == inElement)
+			? *run->elem
+			: Element(inScope, inElement);
 	outValue = elem.GetParameter(inID);
 	return noErr;
 }
 
+//_____________________________________________________________________________
+//
+OSStatus AUBase::GetParameters(
+	AudioUnitScope inScope, AudioUnitElement inElement, std::span<AUParameterIDValue> ioValues)
+{
+	class RunScope {
+	public:
+		explicit RunScope(const ParameterReadRun& run) noexcept
+			: mPrevious{ std::exchange(sParameterReadRun, &run) }
+		{
+		}
+		~RunScope() noexcept { sParameterReadRun = mPrevious; }
+
+		RunScope(const RunScope&) = delete;
+		RunScope(RunScope&&) = delete;
+		RunScope& operator=(const RunScope&) = delete;
+		RunScope& operator=(RunScope&&) = delete;
+
+	private:
+		const ParameterReadRun* mPrevious;
+	};
+
+	const ParameterReadRun run{
+		.unit = this, .scope = inScope, .element = inElement, .elem = &Element(inScope, inElement)
+	};
+	const RunScope runScope{ run };
+	for (auto& value : ioValues) {
+		AUSDK_Require_noerr(GetParameter(value.mParameterID, inScope, inElement, value.mValue));
+	}
+	return noErr;
+}
+
 
 //_____________________________________________________________________________
 //
@@ -1017,6 +1331,351 @@ OSStatus AUBase::SetParameter(AudioUnitParameterID inID, AudioUnitScope inScope,
 	return noErr;
 }
 
+//_____________________________________________________________________________
+//
+OSStatus AUBase::SetParameters(AudioUnitScope inScope, AudioUnitElement inElement,
+	std::span<const AUParameterIDValue> inValues)
+{
+	auto& elem = Element(inScope, inElement);
+	elem.SetParameters(inValues);
+	return noErr;
+}
+
+//_____________________________________________________________________________
+//
+void AUParameterSnapshot::Add(AUElement& element, std::span<const AUParameterIDValue> values)
+{
+	// The IDs are resolved here, dropping undefined ones, so that the render thread only deals
+	// with storage positions and dense arrays, and cannot fail.
+	const size_t begin = mValues.size();
+	for (const auto& item : values) {
+		const auto index = element.IndexOfParameter(item.mParameterID);
+		if (index != AUParameterTableView::npos) {
+			mValues.push_back(item);
+			mIndices.push_back(index);
+			mTarget.push_back(item.mValue);
+		}
+	}
+	if (mValues.size() == begin) {
+		return;
+	}
+	if (!mRuns.empty() && mRuns.back().element == &element) {
+		mRuns.back().end = mValues.size();
+	} else {
+		mRuns.push_back({ .element = &element, .begin = begin, .end = mValues.size() });
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUParameterSnapshot::Apply() const noexcept
+{
+	for (const auto& run : mRuns) {
+		run.element->SetParametersAtIndices(
+			std::span(mIndices).subspan(run.begin, run.end - run.begin),
+			std::span(mTarget).subspan(run.begin, run.end - run.begin));
+	}
+}
+
+//_____________________________________________________________________________
+//
+bool AUParameterSnapshot::TryApply() noexcept
+{
+	for (; mAppliedRuns < mRuns.size(); ++mAppliedRuns) {
+		const auto& run = mRuns[mAppliedRuns];
+		if (!run.element->TrySetParametersAtIndices(
+				std::span(mIndices).subspan(run.begin, run.end - run.begin),
+				std::span(mTarget).subspan(run.begin, run.end - run.begin))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//_____________________________________________________________________________
+//
+void AUParameterSnapshot::PrepareMorph()
+{
+	mSource.resize(mTarget.size());
+	mCurrent.resize(mTarget.size());
+	mIsMorph = true;
+	mMorphStarted = false;
+	mMorphElapsedFrames = 0;
+}
+
+//_____________________________________________________________________________
+//
+bool AUParameterSnapshot::Morph(AudioUnitParameterValue position)
+{
+	if (!mMorphStarted) {
+		for (const auto& run : mRuns) {
+			run.element->GetParametersAtIndices(
+				std::span(mIndices).subspan(run.begin, run.end - run.begin),
+				std::span(mSource).subspan(run.begin, run.end - run.begin));
+		}
+		mMorphStarted = true;
+	}
+
+	// A single dense pass over all of the elements' values, which vectorizes.
+	std::span<const AudioUnitParameterValue> values = mTarget;
+	if (position < 1.f) {
+		const size_t count = mCurrent.size();
+		const AudioUnitParameterValue* const source = mSource.data();
+		const AudioUnitParameterValue* const target = mTarget.data();
+		AudioUnitParameterValue* const current = mCurrent.data();
+		for (size_t i = 0; i < count; ++i) {
+			current[i] = source[i] + (position * (target[i] - source[i])); // NOLINT
+		}
+		values = mCurrent;
+	}
+	// An element which another thread is writing is skipped rather than waited for; the next
+	// slice writes a newer position anyway.
+	bool written = true;
+	for (const auto& run : mRuns) {
+		written = run.element->TrySetParametersAtIndices(
+					  std::span(mIndices).subspan(run.begin, run.end - run.begin),
+					  values.subspan(run.begin, run.end - run.begin)) &&
+				  written;
+	}
+	return written;
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::PublishParameterSnapshot(std::unique_ptr<AUParameterSnapshot> snapshot)
+{
+	ThrowExceptionIf(snapshot == nullptr, kAudio_ParamError);
+	ReclaimParameterSnapshots();
+	if (!mDefersParameterRestore || !IsInitialized()) {
+		snapshot->Apply();
+		return;
+	}
+	EnqueueParameterSnapshot(std::move(snapshot));
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::BeginParameterMorph(
+	std::unique_ptr<AUParameterSnapshot> target, UInt32 durationInFrames)
+{
+	ThrowExceptionIf(target == nullptr, kAudio_ParamError);
+	ThrowExceptionIf(durationInFrames == 0 && !mMorphPositionParameter, kAudio_ParamError);
+	ReclaimParameterSnapshots();
+	if (!IsInitialized()) {
+		target->Apply();
+		return;
+	}
+	target->mIsMorph = true;
+	target->mMorphFrames = durationInFrames;
+	EnqueueParameterSnapshot(std::move(target));
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::EnqueueParameterSnapshot(std::unique_ptr<AUParameterSnapshot> snapshot)
+{
+	// Take back a snapshot which the render thread has not applied yet and carry its values
+	// over, ahead of the new ones.
+	if (const std::unique_ptr<AUParameterSnapshot> pending{
+			mPublishedParameters.exchange(nullptr, std::memory_order_acquire) }) {
+		auto merged = std::make_unique<AUParameterSnapshot>();
+		for (const auto* source : { pending.get(), snapshot.get() }) {
+			for (const auto& run : source->mRuns) {
+				merged->Add(*run.element,
+					std::span(source->mValues).subspan(run.begin, run.end - run.begin));
+			}
+		}
+		merged->mIsMorph = snapshot->mIsMorph;
+		merged->mMorphFrames = snapshot->mMorphFrames;
+		snapshot = std::move(merged);
+	}
+	if (snapshot->mIsMorph) {
+		snapshot->PrepareMorph();
+	}
+	mPublishedParameters.store(snapshot.release(), std::memory_order_release);
+}
+
+//_____________________________________________________________________________
+//
+//	Realtime-safe: the snapshot is only read, and is deleted later by a non-realtime
+//	thread calling ReclaimParameterSnapshots. A snapshot which could not be applied
+//	completely is finished before a newer one is taken, so that they apply in order.
+//
+void AUBase::ApplyPublishedParameters()
+{
+	if (mUnappliedSnapshot != nullptr &&
+		!ApplyParameterSnapshot(std::exchange(mUnappliedSnapshot, nullptr))) {
+		return;
+	}
+	if (mPublishedParameters.load(std::memory_order_relaxed) == nullptr) {
+		return;
+	}
+	AUParameterSnapshot* const snapshot =
+		mPublishedParameters.exchange(nullptr, std::memory_order_acquire);
+	if (snapshot == nullptr) {
+		return;
+	}
+	if (mActiveMorph != nullptr) { // superseded
+		RetireParameterSnapshot(std::exchange(mActiveMorph, nullptr));
+	}
+	if (snapshot->mIsMorph) {
+		mActiveMorph = snapshot;
+		return;
+	}
+	ApplyParameterSnapshot(snapshot);
+}
+
+//_____________________________________________________________________________
+//
+bool AUBase::ApplyParameterSnapshot(AUParameterSnapshot* snapshot) noexcept
+{
+	if (!snapshot->TryApply()) {
+		mUnappliedSnapshot = snapshot;
+		return false;
+	}
+	RetireParameterSnapshot(snapshot);
+	return true;
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::MorphParameters(UInt32 inFramesToProcess)
+{
+	AUParameterSnapshot* const morph = mActiveMorph;
+	if (morph == nullptr) {
+		return;
+	}
+	if (morph->mMorphFrames == 0) {
+		const auto position = Globals()->GetParameter(*mMorphPositionParameter);
+		morph->Morph(std::clamp(position, 0.f, 1.f));
+		return;
+	}
+	const bool written = morph->Morph(static_cast<Float32>(morph->mMorphElapsedFrames) /
+									  static_cast<Float32>(morph->mMorphFrames));
+	if (morph->mMorphElapsedFrames == morph->mMorphFrames) {
+		if (written) { // otherwise the final values are written on the next slice
+			mActiveMorph = nullptr;
+			RetireParameterSnapshot(morph);
+		}
+		return;
+	}
+	morph->mMorphElapsedFrames +=
+		std::min(inFramesToProcess, morph->mMorphFrames - morph->mMorphElapsedFrames);
+}
+
+//_____________________________________________________________________________
+//
+//	A unit is known to slice morphs once it has called ProcessForScheduledParams,
+//	which then skips the morph on a cycle already advanced here.
+//
+void AUBase::AdvanceUnslicedMorph(UInt32 inFramesToProcess)
+{
+	mMorphAdvancedThisCycle = mActiveMorph != nullptr && !mSlicesParameterMorph;
+	if (mMorphAdvancedThisCycle) {
+		MorphParameters(inFramesToProcess);
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::RetireParameterSnapshot(AUParameterSnapshot* snapshot) noexcept
+{
+	snapshot->mNextRetired = mRetiredParameters.load(std::memory_order_relaxed);
+	while (!mRetiredParameters.compare_exchange_weak(snapshot->mNextRetired, snapshot,
+		std::memory_order_release, std::memory_order_relaxed)) {
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::ReclaimParameterSnapshots() noexcept
+{
+	AUParameterSnapshot* snapshot = mRetiredParameters.exchange(nullptr, std::memory_order_acquire);
+	while (snapshot != nullptr) {
+		delete std::exchange(snapshot, snapshot->mNextRetired); // NOLINT owning memory
+	}
+}
+
+//_____________________________________________________________________________
+//
+class AUBase::ParameterRestoreScope {
+public:
+	explicit ParameterRestoreScope(AUBase& unit) : mUnit{ unit }
+	{
+		if (unit.mDefersParameterRestore && unit.IsInitialized()) {
+			unit.mRestoringParameters = std::make_unique<AUParameterSnapshot>();
+		}
+	}
+
+	ParameterRestoreScope(const ParameterRestoreScope&) = delete;
+	ParameterRestoreScope(ParameterRestoreScope&&) = delete;
+	ParameterRestoreScope& operator=(const ParameterRestoreScope&) = delete;
+	ParameterRestoreScope& operator=(ParameterRestoreScope&&) = delete;
+
+	~ParameterRestoreScope() { mUnit.mRestoringParameters.reset(); }
+
+	void Publish()
+	{
+		if (auto snapshot = std::move(mUnit.mRestoringParameters)) {
+			mUnit.PublishParameterSnapshot(std::move(snapshot));
+		}
+	}
+
+private:
+	AUBase& mUnit;
+};
+
+//_____________________________________________________________________________
+//
+// Returns the end of the run of entries starting at `begin` which address the same element.
+template <typename Iterator>
+static Iterator EndOfElementRun(Iterator begin, Iterator end)
+{
+	return std::find_if(begin, end, [&](const AUParameterAddressValue& value) {
+		return value.mScope != begin->mScope || value.mElement != begin->mElement;
+	});
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUBase::GetParameterValues(std::span<AUParameterAddressValue> ioValues)
+{
+	std::vector<AUParameterIDValue> runValues;
+	runValues.reserve(ioValues.size());
+	for (auto run = ioValues.begin(); run != ioValues.end();) {
+		const auto runEnd = EndOfElementRun(run, ioValues.end());
+		runValues.clear();
+		std::transform(run, runEnd, std::back_inserter(runValues),
+			[](const AUParameterAddressValue& value) {
+				return AUParameterIDValue{ value.mParameterID, value.mValue };
+			});
+		AUSDK_Require_noerr(GetParameters(run->mScope, run->mElement, runValues));
+		for (const auto& value : runValues) {
+			(run++)->mValue = value.mValue;
+		}
+	}
+	return noErr;
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUBase::SetParameterValues(std::span<const AUParameterAddressValue> inValues)
+{
+	std::vector<AUParameterIDValue> runValues;
+	runValues.reserve(inValues.size());
+	for (auto run = inValues.begin(); run != inValues.end();) {
+		const auto runEnd = EndOfElementRun(run, inValues.end());
+		runValues.clear();
+		std::transform(run, runEnd, std::back_inserter(runValues),
+			[](const AUParameterAddressValue& value) {
+				return AUParameterIDValue{ value.mParameterID, value.mValue };
+			});
+		AUSDK_Require_noerr(SetParameters(run->mScope, run->mElement, runValues));
+		run = runEnd;
+	}
+	return noErr;
+}
+
 //_____________________________________________________________________________
 //
 OSStatus AUBase::ScheduleParameter(
@@ -1039,6 +1698,20 @@ OSStatus AUBase::ScheduleParameter(
 	return noErr;
 }
 
+// ____________________________________________________________________________
+//
+static AudioUnitParameterValue RampValueAtFrame(const AudioUnitParameterEvent& event, UInt32 frame)
+{
+	const auto& ramp = event.eventValues.ramp; // NOLINT union
+	const Float32 progress =
+		ramp.durationInFrames == 0
+			? 1.f
+			: std::clamp(static_cast<Float32>(static_cast<SInt32>(frame) - ramp.startBufferOffset) /
+							 static_cast<Float32>(ramp.durationInFrames),
+				  0.f, 1.f);
+	return ramp.startValue + (progress * (ramp.endValue - ramp.startValue));
+}
+
 // ____________________________________________________________________________
 //
 constexpr bool ParameterEventListSortPredicate(
@@ -1065,6 +1738,10 @@ OSStatus AUBase::ProcessForScheduledParams(
 
 	UInt32 currentStartFrame = 0; // start of the whole buffer
 
+	// for units which call this from their own render
+	ApplyPublishedParameters();
+	mSlicesParameterMorph = true;
+	const bool morphAdvanced = std::exchange(mMorphAdvancedThisCycle, false);
 
 	// sort the ParameterEventList by startBufferOffset
 	std::ranges::sort(inParamList, ParameterEventListSortPredicate);
@@ -1102,6 +1779,15 @@ OSStatus AUBase::ProcessForScheduledParams(
 			}
 		}
 
+		// a timed morph ends exactly on its last frame, unless this cycle's step is already taken
+		if (!morphAdvanced && mActiveMorph != nullptr && mActiveMorph->mMorphFrames != 0) {
+			const UInt32 morphEndFrame = currentStartFrame + mActiveMorph->mMorphFrames -
+										 mActiveMorph->mMorphElapsedFrames;
+			if (morphEndFrame > currentStartFrame && morphEndFrame < currentEndFrame) {
+				currentEndFrame = morphEndFrame;
+			}
+		}
+
 		const UInt32 framesThisTime = currentEndFrame - currentStartFrame;
 
 		// next, setup the parameter maps to be current for the ramp parameters active during
@@ -1126,13 +1812,25 @@ OSStatus AUBase::ProcessForScheduledParams(
 			if (eventFallsInSlice) {
 				AUElement* const element = GetElement(event.scope, event.element);
 
-				if (element != nullptr) {
+				if (element == nullptr) {
+					continue;
+				}
+				if (event.eventType == kParameterEvent_Ramped &&
+					event.scope == kAudioUnitScope_Global && event.element == 0 &&
+					event.parameter == mMorphPositionParameter) {
+					// AUElement does not ramp, but the morph position is evaluated per slice
+					element->SetParameter(
+						event.parameter, RampValueAtFrame(event, currentStartFrame));
+				} else {
 					element->SetScheduledEvent(event.parameter, event, currentStartFrame,
 						currentEndFrame - currentStartFrame);
 				}
 			}
 		}
 
+		if (!morphAdvanced) {
+			MorphParameters(framesThisTime);
+		}
 
 		// Finally, actually do the processing for this slice.....
 
@@ -1187,6 +1885,7 @@ OSStatus AUBase::DoRender(AudioUnitRenderActionFlags& ioActionFlags,
 	OSStatus theError = noErr;
 
 	[[maybe_unused]] const DenormalDisabler denormalDisabler;
+	const AUEpochDomain::RenderScope renderScope{ mRenderEpochs };
 
 	try {
 		AUSDK_Require(IsInitialized(), errorExit(kAudioUnitErr_Uninitialized));
@@ -1245,6 +1944,11 @@ OSStatus AUBase::DoRender(AudioUnitRenderActionFlags& ioActionFlags,
 			mRenderThreadID = std::this_thread::get_id();
 		}
 
+		if (inTimeStamp.mSampleTime != mCurrentRenderTime.mSampleTime) {
+			ApplyPublishedParameters(); // once per cycle, before any bus renders
+			AdvanceUnslicedMorph(inFramesToProcess);
+		}
+
 		if (mRenderCallbacksTouched) {
 			mRenderCallbacks.Update();
 
@@ -1259,6 +1963,9 @@ OSStatus AUBase::DoRender(AudioUnitRenderActionFlags& ioActionFlags,
 			DoRenderBus(ioActionFlags, inTimeStamp, inBusNumber, output, inFramesToProcess, ioData);
 
 		SetRenderError(theError);
+		if (theError == noErr) {
+			output.Meter(ioData, inFramesToProcess);
+		}
 
 		if (mRenderCallbacksTouched) {
 			AudioUnitRenderActionFlags flags = ioActionFlags | kAudioUnitRenderAction_PostRender;
@@ -1306,6 +2013,7 @@ OSStatus AUBase::DoProcess(AudioUnitRenderActionFlags& ioActionFlags,
 	OSStatus theError = noErr;
 
 	[[maybe_unused]] const DenormalDisabler denormalDisabler;
+	const AUEpochDomain::RenderScope renderScope{ mRenderEpochs };
 
 	try {
 		if (CheckRenderArgs(ioActionFlags)) {
@@ -1355,6 +2063,8 @@ OSStatus AUBase::DoProcess(AudioUnitRenderActionFlags& ioActionFlags,
 		}
 
 		if (NeedsToRender(inTimeStamp)) {
+			ApplyPublishedParameters();
+			AdvanceUnslicedMorph(inFramesToProcess);
 			theError = ProcessBufferLists(ioActionFlags, ioData, ioData, inFramesToProcess);
 		} else {
 			theError = noErr;
@@ -1383,6 +2093,7 @@ OSStatus AUBase::DoProcessMultiple(AudioUnitRenderActionFlags& ioActionFlags,
 	OSStatus theError = noErr;
 
 	[[maybe_unused]] const DenormalDisabler denormalDisabler;
+	const AUEpochDomain::RenderScope renderScope{ mRenderEpochs };
 
 	try {
 		if (CheckRenderArgs(ioActionFlags)) {
@@ -1492,6 +2203,8 @@ OSStatus AUBase::DoProcessMultiple(AudioUnitRenderActionFlags& ioActionFlags,
 		}
 
 		if (NeedsToRender(inTimeStamp)) {
+			ApplyPublishedParameters();
+			AdvanceUnslicedMorph(inFramesToProcess);
 			theError = ProcessMultipleBufferLists(ioActionFlags, inFramesToProcess,
 				inNumberInputBufferLists, inInputBufferLists, inNumberOutputBufferLists,
 				ioOutputBufferLists);
@@ -1818,14 +2531,18 @@ OSStatus AUBase::RestoreState(CFPropertyListRef plist)
 	const auto* const data =
 		static_cast<CFDataRef>(CFDictionaryGetValue(dict, CFSTR(kAUPresetDataKey)));
 	if ((data != nullptr) && (CFGetTypeID(data) == CFDataGetTypeID())) {
+		ParameterRestoreScope restoreScope{ *this };
 		const UInt8* p = CFDataGetBytePtr(data);
 		const UInt8* const pend = p + CFDataGetLength(data); // NOLINT
 
 		while (p < pend) {
+			AUSDK_Require(pend - p >= static_cast<std::ptrdiff_t>(sizeof(UInt32)),
+				kAudioUnitErr_InvalidPropertyValue);
 			const auto scopeIndex = DeserializeBigUInt32AndAdvance(p);
 			const auto& scope = GetScope(scopeIndex);
-			p = scope.RestoreState(p);
+			p = scope.RestoreState(p, pend);
 		}
+		restoreScope.Publish();
 	}
 
 	// OK - now we're going to do some properties
@@ -1876,11 +2593,369 @@ OSStatus AUBase::RestoreState(CFPropertyListRef plist)
 	return noErr;
 }
 
-OSStatus AUBase::GetPresets(CFArrayRef* /*outData*/) const { return kAudioUnitErr_InvalidProperty; }
+//_____________________________________________________________________________
+//
+// The UTF-8 bytes of a string, for the binary state.
+static std::vector<UInt8> CopyUTF8Bytes(CFStringRef string)
+{
+	const auto range = CFRangeMake(0, CFStringGetLength(string));
+	CFIndex size = 0;
+	CFStringGetBytes(string, range, kCFStringEncodingUTF8, 0, false, nullptr, 0, &size);
+	std::vector<UInt8> bytes(static_cast<size_t>(size));
+	CFStringGetBytes(
+		string, range, kCFStringEncodingUTF8, 0, false, bytes.data(), size, nullptr);
+	return bytes;
+}
 
-OSStatus AUBase::NewFactoryPresetSet(const AUPreset& /*inNewFactoryPreset*/)
+//_____________________________________________________________________________
+//
+// Invokes `f(scopeIndex, elementIndex, element)` for each element whose parameters are saved,
+// i.e. those of the global, input and output scopes, as in SaveState.
+template <typename F>
+static void ForEachSavedElement(AUBase& unit, F&& f)
 {
-	return kAudioUnitErr_InvalidProperty;
+	constexpr AudioUnitScope numSavedScopes = 3;
+	for (AudioUnitScope iscope = 0; iscope < numSavedScopes; ++iscope) {
+		const auto& scope = unit.GetScope(iscope);
+		for (UInt32 ielem = 0; ielem < scope.GetNumberOfElements(); ++ielem) {
+			f(iscope, ielem, *scope.GetElement(ielem));
+		}
+	}
+}
+
+//_____________________________________________________________________________
+//
+// NOLINTNEXTLINE(misc-no-recursion) with DispatchGetProperty
+OSStatus AUBase::SaveBinaryState(CFDataRef* outData) { return WriteBinaryState(outData, false); }
+
+//_____________________________________________________________________________
+//
+// NOLINTNEXTLINE(misc-no-recursion) with DispatchGetProperty
+OSStatus AUBase::SaveDeltaState(CFDataRef* outData) { return WriteBinaryState(outData, true); }
+
+//_____________________________________________________________________________
+//
+//	The state is sized up front from the elements' parameter counts and written
+//	in one pass into a single CFData, avoiding the property list and the
+//	per-value CF calls of SaveState.
+//
+// NOLINTNEXTLINE(misc-no-recursion) with DispatchGetProperty
+OSStatus AUBase::WriteBinaryState(CFDataRef* outData, bool delta)
+{
+	const AudioComponentDescription desc = GetComponentDescription();
+	constexpr auto word = AUBinaryState::kWordSize;
+
+	const CFStringRef presetName = mCurrentPreset.presetName;
+	const auto nameRange =
+		CFRangeMake(0, presetName != nullptr ? CFStringGetLength(presetName) : 0);
+	CFIndex nameSize = 0;
+	if (presetName != nullptr) {
+		CFStringGetBytes(presetName, nameRange, kCFStringEncodingUTF8, 0, false, nullptr, 0,
+			&nameSize);
+	}
+
+	UInt32 renderQuality = 0;
+	const bool hasRenderQuality = DispatchGetProperty(kAudioUnitProperty_RenderQuality,
+									  kAudioUnitScope_Global, 0, &renderQuality) == noErr;
+
+	const auto extendedScopes =
+		Owned<CFMutableDataRef>::from_create(CFDataCreateMutable(nullptr, 0));
+	SaveExtendedScopes(*extendedScopes);
+	const auto extendedScopesData = std::span(CFDataGetBytePtr(*extendedScopes),
+		static_cast<size_t>(CFDataGetLength(*extendedScopes)));
+
+	// element names, of every scope, as SaveState saves them
+	struct ElementName {
+		AudioUnitScope scope;
+		AudioUnitElement element;
+		std::vector<UInt8> utf8;
+	};
+	std::vector<ElementName> elementNames;
+	for (AudioUnitScope iscope = 0; iscope < kNumScopes; ++iscope) {
+		const auto& scope = GetScope(iscope);
+		for (UInt32 ielem = 0; ielem < scope.GetNumberOfElements(); ++ielem) {
+			const AUElement* const element = scope.GetElement(ielem);
+			if (element != nullptr && element->HasName()) {
+				elementNames.push_back({ .scope = iscope,
+					.element = ielem,
+					.utf8 = CopyUTF8Bytes(*element->GetName()) });
+			}
+		}
+	}
+
+	// A delta is based on the previous one, unless an element's parameters have been redefined
+	// since, in which case it starts a new chain from the defaults.
+	bool fromDefaults = mStateGeneration == 0;
+	size_t capacity = AUBinaryState::kHeaderSize + word +
+					  AUBinaryState::PaddedSize(static_cast<size_t>(nameSize)) + word + word +
+					  AUBinaryState::PaddedSize(extendedScopesData.size()) + word +
+					  (delta ? 4 * word : 0);
+	for (const auto& elementName : elementNames) {
+		capacity += (3 * word) + AUBinaryState::PaddedSize(elementName.utf8.size());
+	}
+	ForEachSavedElement(*this, [&](AudioUnitScope, UInt32, const AUElement& element) {
+		capacity += (3 * word) + (element.ParameterCount() * AUBinaryState::kParameterSize);
+		fromDefaults = fromDefaults || !element.HasStateBase();
+	});
+
+	auto data = Owned<CFMutableDataRef>::from_create(CFDataCreateMutable(nullptr, 0));
+	CFDataSetLength(*data, static_cast<CFIndex>(capacity));
+	AUBinaryStateWriter writer{ std::span(CFDataGetMutableBytePtr(*data), capacity) };
+
+	writer.WriteUInt32(AUBinaryState::kMagic);
+	writer.WriteUInt32(AUBinaryState::kVersion);
+	writer.WriteUInt32(desc.componentType);
+	writer.WriteUInt32(desc.componentSubType);
+	writer.WriteUInt32(desc.componentManufacturer);
+	writer.WriteUInt32((hasRenderQuality ? AUBinaryState::kFlagRenderQuality : 0) |
+					   (delta ? AUBinaryState::kFlagDelta : 0));
+	writer.WriteUInt32(0); // payload size
+	writer.WriteUInt32(0); // checksum
+
+	writer.WriteUInt32(static_cast<UInt32>(nameSize));
+	if (nameSize > 0) {
+		CFStringGetBytes(presetName, nameRange, kCFStringEncodingUTF8, 0, false,
+			writer.Claim(static_cast<size_t>(nameSize)).data(), nameSize, nullptr);
+	}
+	writer.Pad();
+	writer.WriteUInt32(renderQuality);
+	writer.WriteBlock(extendedScopesData);
+	writer.WriteUInt32(static_cast<UInt32>(elementNames.size()));
+	for (const auto& elementName : elementNames) {
+		writer.WriteUInt32(elementName.scope);
+		writer.WriteUInt32(elementName.element);
+		writer.WriteBlock(elementName.utf8);
+	}
+
+	const UInt64 generation = mStateGeneration + 1;
+	if (delta) {
+		writer.WriteUInt64(fromDefaults ? 0 : mStateGeneration);
+		writer.WriteUInt64(generation);
+	}
+
+	ForEachSavedElement(*this, [&](AudioUnitScope iscope, UInt32 ielem, AUElement& element) {
+		if (element.GetNumberOfParameters() == 0) {
+			return;
+		}
+		const auto recordOffset = writer.Size();
+		writer.WriteUInt32(iscope);
+		writer.WriteUInt32(ielem);
+		const auto countOffset = writer.Size();
+		writer.WriteUInt32(0);
+		UInt32 count = 0;
+		const auto writeParameter = [&](AudioUnitParameterID paramID,
+										AudioUnitParameterValue value) {
+			writer.WriteUInt32(paramID);
+			writer.WriteFloat32(value);
+			++count;
+		};
+		if (!delta) {
+			element.ForEachSavedParameter(iscope, writeParameter);
+		} else {
+			element.ForEachChangedSavedParameter(iscope, fromDefaults, writeParameter);
+			if (count == 0) {
+				writer.Truncate(recordOffset);
+				return;
+			}
+		}
+		writer.WriteAt(countOffset, count);
+	});
+
+	const auto payload = writer.Written().subspan(AUBinaryState::kHeaderSize);
+	writer.WriteAt(AUBinaryState::kPayloadSizeOffset, static_cast<UInt32>(payload.size()));
+	writer.WriteAt(AUBinaryState::kChecksumOffset, AUBinaryState::Checksum(payload));
+	CFDataSetLength(*data, static_cast<CFIndex>(writer.Size()));
+
+	if (delta) {
+		ForEachSavedElement(*this,
+			[](AudioUnitScope, UInt32, AUElement& element) { element.CommitStateBase({}); });
+		mStateGeneration = generation;
+	}
+
+	*outData = data.release(); // transfer ownership
+	return noErr;
+}
+
+//_____________________________________________________________________________
+//
+// NOLINTNEXTLINE(misc-no-recursion) with DispatchSetProperty
+OSStatus AUBase::RestoreBinaryState(CFDataRef data)
+{
+	AUSDK_Require(data != nullptr, kAudioUnitErr_InvalidPropertyValue);
+	AUSDK_Require(CFGetTypeID(data) == CFDataGetTypeID(), kAudioUnitErr_InvalidPropertyValue);
+
+	const AudioComponentDescription desc = GetComponentDescription();
+	AUBinaryStateReader reader{ std::span(
+		CFDataGetBytePtr(data), static_cast<size_t>(CFDataGetLength(data))) };
+
+	// As with ClassInfo, the component type is not checked, since there may be different
+	// versions (effect, format-converter, offline) of essentially the same AU.
+	AUSDK_Require(reader.ReadUInt32() == AUBinaryState::kMagic, kAudioUnitErr_InvalidPropertyValue);
+	const auto version = reader.ReadUInt32();
+	AUSDK_Require(version >= AUBinaryState::kOldestVersion && version <= AUBinaryState::kVersion,
+		kAudioUnitErr_InvalidPropertyValue);
+	reader.ReadUInt32(); // componentType
+	AUSDK_Require(reader.ReadUInt32() == desc.componentSubType, kAudioUnitErr_InvalidPropertyValue);
+	AUSDK_Require(
+		reader.ReadUInt32() == desc.componentManufacturer, kAudioUnitErr_InvalidPropertyValue);
+	const auto flags = reader.ReadUInt32();
+	const auto payloadSize = reader.ReadUInt32();
+	const auto checksum = reader.ReadUInt32();
+	AUSDK_Require(payloadSize == reader.Remaining(), kAudioUnitErr_InvalidPropertyValue);
+	const auto payloadData = reader.ReadBytes(payloadSize);
+	AUSDK_Require(
+		AUBinaryState::Checksum(payloadData) == checksum, kAudioUnitErr_InvalidPropertyValue);
+
+	AUBinaryStateReader payload{ payloadData };
+	const auto name = payload.ReadBlock();
+	const auto renderQuality = payload.ReadUInt32();
+	const auto extendedScopesData = payload.ReadBlock();
+
+	struct ElementName {
+		AudioUnitScope scope;
+		AudioUnitElement element;
+		std::span<const UInt8> utf8;
+	};
+	std::vector<ElementName> elementNames;
+	if (version >= AUBinaryState::kFirstVersionWithElementNames) {
+		const auto nameCount = payload.ReadUInt32();
+		// each name takes at least three words, which bounds the count by the data
+		AUSDK_Require(nameCount <= payload.Remaining() / (3 * AUBinaryState::kWordSize),
+			kAudioUnitErr_InvalidPropertyValue);
+		elementNames.reserve(nameCount);
+		for (UInt32 i = 0; i < nameCount; ++i) {
+			const auto scope = payload.ReadUInt32();
+			const auto element = payload.ReadUInt32();
+			elementNames.push_back(
+				{ .scope = scope, .element = element, .utf8 = payload.ReadBlock() });
+		}
+	}
+
+	// A delta applies on top of its base: the defaults, or the state of the delta last saved or
+	// restored, whose values the elements keep. Elements it has no record for revert to the base.
+	const bool delta = (flags & AUBinaryState::kFlagDelta) != 0u;
+	UInt64 baseGeneration = 0;
+	UInt64 generation = 0;
+	if (delta) {
+		baseGeneration = payload.ReadUInt64();
+		generation = payload.ReadUInt64();
+		AUSDK_Require(generation != 0, kAudioUnitErr_InvalidPropertyValue);
+		if (baseGeneration != 0) {
+			AUSDK_Require(baseGeneration == mStateGeneration, kAudioUnitErr_InvalidPropertyValue);
+			bool haveBase = true;
+			ForEachSavedElement(*this, [&](AudioUnitScope, UInt32, const AUElement& element) {
+				haveBase = haveBase && element.HasStateBase();
+			});
+			AUSDK_Require(haveBase, kAudioUnitErr_InvalidPropertyValue);
+		}
+	}
+	const bool fromDefaults = baseGeneration == 0;
+
+	ParameterRestoreScope restoreScope{ *this };
+	std::vector<AUParameterIDValue> values;
+	std::vector<const AUElement*> restoredElements;
+	while (!payload.AtEnd()) {
+		const auto scopeIndex = payload.ReadUInt32();
+		const auto elementIndex = payload.ReadUInt32();
+		const auto count = payload.ReadUInt32();
+		AUBinaryStateReader entries{ payload.ReadBytes(
+			size_t{ count } * AUBinaryState::kParameterSize) };
+		AUElement* const element = GetScope(scopeIndex).GetElement(elementIndex);
+		if (element == nullptr) {
+			continue;
+		}
+		values.clear();
+		if (delta) {
+			element->AppendStateBase(scopeIndex, fromDefaults, values);
+			restoredElements.push_back(element);
+		}
+		const auto offset = values.size();
+		values.resize(offset + count);
+		for (auto& item : std::span(values).subspan(offset)) {
+			item.mParameterID = entries.ReadUInt32();
+			item.mValue = entries.ReadFloat32();
+		}
+		element->RestoreParameters(values); // later entries win over the base
+		if (delta) {
+			element->CommitStateBase(values);
+		}
+	}
+	if (delta) {
+		ForEachSavedElement(*this, [&](AudioUnitScope iscope, UInt32, AUElement& element) {
+			if (std::ranges::find(restoredElements, &element) == restoredElements.end()) {
+				values.clear();
+				element.AppendStateBase(iscope, fromDefaults, values);
+				element.RestoreParameters(values);
+				element.CommitStateBase(values);
+			}
+		});
+		mStateGeneration = generation;
+	}
+
+	AUBinaryStateReader extendedScopes{ extendedScopesData };
+	while (!extendedScopes.AtEnd()) {
+		const auto& scope = GetScope(extendedScopes.ReadBigUInt32());
+		const auto unread = extendedScopes.Unread();
+		const UInt8* const end = scope.RestoreState(unread.data(), unread.data() + unread.size());
+		extendedScopes.ReadBytes(static_cast<size_t>(end - unread.data()));
+	}
+	restoreScope.Publish();
+
+	if (mCurrentPreset.presetName != nullptr) {
+		CFRelease(mCurrentPreset.presetName);
+	}
+	mCurrentPreset.presetName = nullptr;
+	if (!name.empty()) {
+		mCurrentPreset.presetName = CFStringCreateWithBytes(nullptr, name.data(),
+			static_cast<CFIndex>(name.size()), kCFStringEncodingUTF8, false);
+	}
+	if (mCurrentPreset.presetName == nullptr) { // no (valid) name, make the default one
+		CFRetain(mCurrentPreset.presetName = GetPresetDefaultName());
+	}
+	mCurrentPreset.presetNumber = -1;
+	PropertyChanged(kAudioUnitProperty_PresentPreset, kAudioUnitScope_Global, 0);
+
+	if ((flags & AUBinaryState::kFlagRenderQuality) != 0u) {
+		DispatchSetProperty(kAudioUnitProperty_RenderQuality, kAudioUnitScope_Global, 0,
+			&renderQuality, sizeof(renderQuality));
+	}
+
+	// as with ClassInfo, names of elements which do not exist are ignored
+	for (const auto& elementName : elementNames) {
+		if (elementName.scope >= kNumScopes) {
+			continue;
+		}
+		AUElement* const element = GetScope(elementName.scope).GetElement(elementName.element);
+		const auto name = Owned<CFStringRef>::from_create(CFStringCreateWithBytes(nullptr,
+			elementName.utf8.data(), static_cast<CFIndex>(elementName.utf8.size()),
+			kCFStringEncodingUTF8, false));
+		if (element != nullptr && *name != nullptr) {
+			element->SetName(*name);
+			PropertyChanged(kAudioUnitProperty_ElementName, elementName.scope, elementName.element);
+		}
+	}
+
+	return noErr;
+}
+
+OSStatus AUBase::GetPresets(CFArrayRef* outData) const
+{
+	AUSDK_Require(mFactoryPresetBank, kAudioUnitErr_InvalidProperty);
+	return mFactoryPresetBank->CopyPresets(outData);
+}
+
+OSStatus AUBase::NewFactoryPresetSet(const AUPreset& inNewFactoryPreset)
+{
+	AUSDK_Require(mFactoryPresetBank, kAudioUnitErr_InvalidProperty);
+	const auto index = mFactoryPresetBank->Find(inNewFactoryPreset.presetNumber);
+	AUSDK_Require(index.has_value(), kAudioUnitErr_InvalidPropertyValue);
+
+	const auto state = mFactoryPresetBank->StateAt(*index);
+	AUSDK_Require_noerr(RestoreBinaryState(*state));
+	const auto name = mFactoryPresetBank->NameAt(*index);
+	SetAFactoryPresetAsCurrent({ .presetNumber = inNewFactoryPreset.presetNumber,
+		.presetName = *name });
+	return noErr;
 }
 
 OSStatus AUBase::NewCustomPresetSet(const AUPreset& inNewCustomPreset)
@@ -1955,6 +3030,33 @@ OSStatus AUBase::GetParameterInfo(AudioUnitScope /*inScope*/,
 	return kAudioUnitErr_InvalidParameter;
 }
 
+//_____________________________________________________________________________
+//
+//	Parameter info is immutable between ParameterList/ParameterInfo notifications,
+//	so hosts scanning it repeatedly are answered from the elements' caches.
+//
+OSStatus AUBase::GetCachedParameterInfo(AudioUnitScope inScope,
+	AudioUnitParameterID inParameterID, AudioUnitParameterInfo& outParameterInfo)
+{
+	const auto metadata = inScope < kNumScopes
+							  ? GetScope(inScope).CopyParameterMetadata(inParameterID)
+							  : std::nullopt;
+	if (!metadata) {
+		return GetParameterInfo(inScope, inParameterID, outParameterInfo);
+	}
+	outParameterInfo = metadata->info; // with the names retained for the client
+	return metadata->status;
+}
+
+//_____________________________________________________________________________
+//
+void AUBase::InvalidateParameterMetadata()
+{
+	for (const auto& scope : mScopes) {
+		scope.InvalidateParameterMetadata();
+	}
+}
+
 //_____________________________________________________________________________
 //
 OSStatus AUBase::GetParameterValueStrings(
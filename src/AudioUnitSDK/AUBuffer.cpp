@@ -7,8 +7,13 @@
 
 #include <AudioToolbox/AUComponent.h>
 
+#include <sys/mman.h>
+
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <mutex>
 
 namespace ausdk {
 
@@ -86,6 +91,62 @@ void BufferAllocator::Deallocate(AllocatedBuffer* allocatedBuffer)
 }
 
 
+namespace {
+
+// The zero pool is a series of read-only anonymous mappings, each twice the size of the last,
+// which are never unmapped since silent buffers may still point into them. Untouched pages of
+// such a mapping all share the kernel's zero page, so even a large pool costs no memory.
+constexpr size_t kZeroRegionBaseSize = 16384;
+constexpr size_t kMaxZeroRegions = 32;
+
+std::array<std::atomic<const std::byte*>, kMaxZeroRegions> gZeroRegions{};
+std::atomic<size_t> gZeroRegionCount{ 0 };
+std::mutex gZeroRegionMutex;
+
+constexpr size_t ZeroRegionSize(size_t index) noexcept { return kZeroRegionBaseSize << index; }
+
+} // namespace
+
+void AUZeroBufferPool::Reserve(UInt32 inBytes)
+{
+	const std::lock_guard lock{ gZeroRegionMutex };
+	auto count = gZeroRegionCount.load(std::memory_order_relaxed);
+	while (count == 0 || ZeroRegionSize(count - 1) < inBytes) {
+		if (count == kMaxZeroRegions) {
+			ThrowBadAlloc();
+		}
+		void* const region = mmap(nullptr, ZeroRegionSize(count), PROT_READ,
+			MAP_PRIVATE | MAP_ANON, -1, 0); // NOLINT signed bitwise
+		if (region == MAP_FAILED) {         // NOLINT cast
+			ThrowBadAlloc();
+		}
+		gZeroRegions[count].store(static_cast<const std::byte*>(region), std::memory_order_relaxed);
+		gZeroRegionCount.store(++count, std::memory_order_release);
+	}
+}
+
+const void* AUZeroBufferPool::Get(UInt32 inBytes) noexcept
+{
+	const auto count = gZeroRegionCount.load(std::memory_order_acquire);
+	if (count == 0 || ZeroRegionSize(count - 1) < inBytes) {
+		return nullptr;
+	}
+	return gZeroRegions[count - 1].load(std::memory_order_relaxed);
+}
+
+bool AUZeroBufferPool::Contains(const void* inData) noexcept
+{
+	const auto* const data = static_cast<const std::byte*>(inData);
+	const auto count = gZeroRegionCount.load(std::memory_order_acquire);
+	for (size_t index = 0; index < count; ++index) {
+		const auto* const region = gZeroRegions[index].load(std::memory_order_relaxed);
+		if (data >= region && data < region + ZeroRegionSize(index)) { // NOLINT ptr math
+			return true;
+		}
+	}
+	return false;
+}
+
 AudioBufferList& AllocatedBuffer::Prepare(UInt32 channelsPerBuffer, UInt32 bytesPerBuffer)
 {
 	if (mAudioBufferList.mNumberBuffers > mMaximumNumberBuffers) {
@@ -178,6 +239,25 @@ void AUBufferList::Allocate(const AudioStreamBasicDescription& format, UInt32 nF
 	mPtrState = EPtrState::Invalid;
 }
 
+void AUBufferList::Silence()
+{
+	auto& abl = GetBufferList();
+	if (mPtrState == EPtrState::ToMyMemory) {
+		UInt32 maxBytes = 0;
+		for (UInt32 i = 0; i < abl.mNumberBuffers; ++i) {
+			maxBytes = std::max(maxBytes, abl.mBuffers[i].mDataByteSize); // NOLINT
+		}
+		if (const void* const zeros = AUZeroBufferPool::Get(maxBytes)) {
+			for (UInt32 i = 0; i < abl.mNumberBuffers; ++i) {
+				abl.mBuffers[i].mData = const_cast<void*>(zeros); // NOLINT
+			}
+			mPtrState = EPtrState::ToExternalMemory;
+			return;
+		}
+	}
+	ZeroBuffer(abl);
+}
+
 void AUBufferList::Deallocate()
 {
 	if (mBuffers != nullptr) {
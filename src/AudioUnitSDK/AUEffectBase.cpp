@@ -5,7 +5,9 @@
 #include <AudioUnitSDK/AUEffectBase.h>
 #include <AudioUnitSDK/AUUtility.h>
 
+#include <array>
 #include <cstddef>
+#include <cstring>
 
 /*
 	This class does not deal as well as it should with N-M effects...
@@ -38,6 +40,39 @@ void AUEffectBase::Cleanup()
 	mMainInput = nullptr;
 }
 
+//_____________________________________________________________________________
+//
+void AUEffectBase::SetSharesSilentBuffers(bool inSharesSilentBuffers)
+{
+	mSharesSilentBuffers = inSharesSilentBuffers;
+	// before the elements exist, ReallocateBuffers() reserves instead
+	if (mSharesSilentBuffers && Outputs().GetNumberOfElements() > 0) {
+		ReserveSilentBuffers();
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUEffectBase::ReallocateBuffers()
+{
+	AUBase::ReallocateBuffers();
+	if (mSharesSilentBuffers) {
+		ReserveSilentBuffers();
+	}
+}
+
+//_____________________________________________________________________________
+//
+//	Only units which share silent buffers reserve zeros, enough for any of their output buffers.
+//
+void AUEffectBase::ReserveSilentBuffers()
+{
+	const UInt32 bytes = GetMaxFramesPerSlice() * Output(0).GetStreamFormat().mBytesPerFrame;
+	if (bytes > 0) {
+		AUZeroBufferPool::Reserve(bytes);
+	}
+}
+
 
 //_____________________________________________________________________________
 //
@@ -112,70 +147,49 @@ OSStatus AUEffectBase::Reset(AudioUnitScope inScope, AudioUnitElement inElement)
 	return AUBase::Reset(inScope, inElement);
 }
 
-OSStatus AUEffectBase::GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
-	AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable)
+const AUPropertyRegistry& AUEffectBase::GetPropertyRegistry() const
 {
-	if (inScope == kAudioUnitScope_Global) {
-		switch (inID) {
-		case kAudioUnitProperty_BypassEffect:
-		case kAudioUnitProperty_InPlaceProcessing:
-			outWritable = true;
-			outDataSize = sizeof(UInt32);
-			return noErr;
-		default:
-			break;
-		}
-	}
-	return AUBase::GetPropertyInfo(inID, inScope, inElement, outDataSize, outWritable);
-}
-
-
-OSStatus AUEffectBase::GetProperty(
-	AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement, void* outData)
-{
-	if (inScope == kAudioUnitScope_Global) {
-		switch (inID) {
-		case kAudioUnitProperty_BypassEffect:
-			Serialize<UInt32>(IsBypassEffect() ? 1 : 0, outData);
-			return noErr;
-		case kAudioUnitProperty_InPlaceProcessing:
-			Serialize<UInt32>(mProcessesInPlace ? 1 : 0, outData);
-			return noErr;
-		default:
-			break;
-		}
-	}
-	return AUBase::GetProperty(inID, inScope, inElement, outData);
-}
-
-
-OSStatus AUEffectBase::SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-	AudioUnitElement inElement, const void* inData, UInt32 inDataSize)
-{
-	if (inScope == kAudioUnitScope_Global) {
-		switch (inID) {
-		case kAudioUnitProperty_BypassEffect: {
-			AUSDK_Require(inDataSize >= sizeof(UInt32), kAudioUnitErr_InvalidPropertyValue);
-
-			const bool tempNewSetting = Deserialize<UInt32>(inData) != 0;
-			// we're changing the state of bypass
-			if (tempNewSetting != IsBypassEffect()) {
-				if (!tempNewSetting && IsBypassEffect() &&
-					IsInitialized()) { // turning bypass off and we're initialized
-					Reset(kAudioUnitScope_Global, 0);
-				}
-				SetBypassEffect(tempNewSetting);
-			}
-			return noErr;
-		}
-		case kAudioUnitProperty_InPlaceProcessing:
-			mProcessesInPlace = Deserialize<UInt32>(inData) != 0;
-			return noErr;
-		default:
-			break;
-		}
-	}
-	return AUBase::SetProperty(inID, inScope, inElement, inData, inDataSize);
+	static const AUPropertyRegistry registry{ AUBase::GetPropertyRegistry(),
+		std::array{
+			AUPropertyRegistry::Handler{ .id = kAudioUnitProperty_BypassEffect,
+				.dataSize = sizeof(UInt32),
+				.writable = true,
+				.get = [](AUBase& unit, AudioUnitPropertyID, AudioUnitScope, AudioUnitElement,
+						   void* outData) -> OSStatus {
+					const auto& effect = static_cast<AUEffectBase&>(unit);
+					Serialize<UInt32>(effect.IsBypassEffect() ? 1 : 0, outData);
+					return noErr;
+				},
+				.set = [](AUBase& unit, AudioUnitPropertyID, AudioUnitScope, AudioUnitElement,
+						   const void* inData, UInt32) -> OSStatus {
+					auto& effect = static_cast<AUEffectBase&>(unit);
+					const bool tempNewSetting = Deserialize<UInt32>(inData) != 0;
+					// we're changing the state of bypass
+					if (tempNewSetting != effect.IsBypassEffect()) {
+						if (!tempNewSetting && effect.IsBypassEffect() &&
+							effect.IsInitialized()) { // turning bypass off and we're initialized
+							effect.Reset(kAudioUnitScope_Global, 0);
+						}
+						effect.SetBypassEffect(tempNewSetting);
+					}
+					return noErr;
+				} },
+			AUPropertyRegistry::Handler{ .id = kAudioUnitProperty_InPlaceProcessing,
+				.dataSize = sizeof(UInt32),
+				.writable = true,
+				.get = [](AUBase& unit, AudioUnitPropertyID, AudioUnitScope, AudioUnitElement,
+						   void* outData) -> OSStatus {
+					const auto& effect = static_cast<AUEffectBase&>(unit);
+					Serialize<UInt32>(effect.mProcessesInPlace ? 1 : 0, outData);
+					return noErr;
+				},
+				.set = [](AUBase& unit, AudioUnitPropertyID, AudioUnitScope, AudioUnitElement,
+						   const void* inData, UInt32) -> OSStatus {
+					static_cast<AUEffectBase&>(unit).mProcessesInPlace =
+						Deserialize<UInt32>(inData) != 0;
+					return noErr;
+				} } } };
+	return registry;
 }
 
 
@@ -285,7 +299,10 @@ OSStatus AUEffectBase::Render(
 	AUSDK_Require_noerr(
 		mMainInput->PullInput(ioActionFlags, inTimeStamp, 0 /* element */, nFrames));
 
-	if (ProcessesInPlace() && mMainOutput->WillAllocateBuffer()) {
+	// the shared zeros are read-only, so an input pointing at them is processed out of place
+	const bool inPlace =
+		ProcessesInPlace() && !AUZeroBufferPool::Contains(mMainInput->GetBufferList());
+	if (inPlace && mMainOutput->WillAllocateBuffer()) {
 		mMainOutput->SetBufferList(mMainInput->GetBufferList());
 	}
 
@@ -294,13 +311,13 @@ OSStatus AUEffectBase::Render(
 	if (ShouldBypassEffect()) {
 		// leave silence bit alone
 
-		if (!ProcessesInPlace()) {
+		if (!inPlace) {
 			mMainInput->CopyBufferContentsTo(mMainOutput->GetBufferList());
 		}
 	} else {
 		auto& paramEventList = GetParamEventList();
 
-		if (paramEventList.empty()) {
+		if (paramEventList.empty() && !IsMorphingParameters()) {
 			// this will read/write silence bit
 			result = ProcessBufferLists(
 				ioActionFlags, mMainInput->GetBufferList(), mMainOutput->GetBufferList(), nFrames);
@@ -338,8 +355,12 @@ OSStatus AUEffectBase::Render(
 		}
 	}
 
-	if (((ioActionFlags & kAudioUnitRenderAction_OutputIsSilence) != 0u) && !ProcessesInPlace()) {
-		AUBufferList::ZeroBuffer(mMainOutput->GetBufferList());
+	if (((ioActionFlags & kAudioUnitRenderAction_OutputIsSilence) != 0u) && !inPlace) {
+		if (mSharesSilentBuffers) {
+			mMainOutput->SilenceBuffer();
+		} else {
+			AUBufferList::ZeroBuffer(mMainOutput->GetBufferList());
+		}
 	}
 
 	return result;
@@ -353,8 +374,10 @@ OSStatus AUEffectBase::ProcessBufferLists(AudioUnitRenderActionFlags& ioActionFl
 		return noErr;
 	}
 
+	const bool hostSilent = (ioActionFlags & kAudioUnitRenderAction_OutputIsSilence) != 0;
 	const bool silentInput = IsInputSilent(ioActionFlags, inFramesToProcess);
 	ioActionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+	bool skippedOutOfPlace = false;
 
 	for (UInt32 channel = 0; channel < mKernelList.size(); ++channel) {
 		auto& kernel = mKernelList[channel];
@@ -367,11 +390,34 @@ OSStatus AUEffectBase::ProcessBufferLists(AudioUnitRenderActionFlags& ioActionFl
 		const AudioBuffer* const srcBuffer = &inBuffer.mBuffers[channel]; // NOLINT subscript
 		AudioBuffer* const destBuffer = &outBuffer.mBuffers[channel];     // NOLINT subscript
 
+		if (kernel->mIdle) {
+			if (hostSilent && mSkipsSilentKernels) {
+				skippedOutOfPlace = skippedOutOfPlace || (destBuffer->mData != srcBuffer->mData);
+				continue;
+			}
+			kernel->mIdle = false;
+			kernel->Resume();
+		}
+
 		kernel->Process(static_cast<const Float32*>(srcBuffer->mData),
 			static_cast<Float32*>(destBuffer->mData), inFramesToProcess, ioSilence);
 
 		if (!ioSilence) {
 			ioActionFlags &= ~kAudioUnitRenderAction_OutputIsSilence;
+		} else if (silentInput && mSkipsSilentKernels) {
+			// the input has outlasted the tail and the kernel agrees that it has finished
+			kernel->mIdle = true;
+		}
+	}
+
+	// an out-of-place output is only zeroed by Render() when every channel is silent
+	if (skippedOutOfPlace && (ioActionFlags & kAudioUnitRenderAction_OutputIsSilence) == 0) {
+		for (UInt32 channel = 0; channel < mKernelList.size(); ++channel) {
+			const auto& kernel = mKernelList[channel];
+			AudioBuffer& destBuffer = outBuffer.mBuffers[channel]; // NOLINT subscript
+			if (kernel && kernel->mIdle && destBuffer.mData != inBuffer.mBuffers[channel].mData) {
+				std::memset(destBuffer.mData, 0, destBuffer.mDataByteSize);
+			}
 		}
 	}
 
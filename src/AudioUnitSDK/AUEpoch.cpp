@@ -0,0 +1,98 @@
+/*!
+	@file		AudioUnitSDK/AUEpoch.cpp
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#include <AudioUnitSDK/AUEpoch.h>
+
+#include <algorithm>
+
+namespace ausdk {
+
+//_____________________________________________________________________________
+//
+AUEpochDomain::~AUEpochDomain()
+{
+	StopReclaimer();
+	for (const auto& retired : mRetired) {
+		retired.destroy(retired.object);
+	}
+}
+
+//_____________________________________________________________________________
+//
+//	The epoch is advanced after the object has been made unreachable, so a render cycle which
+//	records the new epoch, or a later one, cannot see it.
+//
+void AUEpochDomain::Retire(void* object, void (*destroy)(void*) noexcept)
+{
+	const std::lock_guard lock{ mRetiredMutex };
+	mRetired.push_back({ .epoch = mEpoch.fetch_add(1, std::memory_order_seq_cst) + 1,
+		.object = object,
+		.destroy = destroy });
+}
+
+//_____________________________________________________________________________
+//
+//	An object retired in epoch E is safe once the render thread is idle or in a cycle which
+//	began in epoch E or later. The objects are deleted outside the lock.
+//
+size_t AUEpochDomain::Reclaim()
+{
+	std::vector<Retired> reclaimed;
+	{
+		const std::lock_guard lock{ mRetiredMutex };
+		const UInt64 renderEpoch = mRenderEpoch.load(std::memory_order_seq_cst);
+		const auto [first, last] = std::ranges::partition(mRetired,
+			[renderEpoch](const Retired& retired) { return retired.epoch > renderEpoch; });
+		reclaimed.assign(first, last);
+		mRetired.erase(first, last);
+	}
+	for (const auto& retired : reclaimed) {
+		retired.destroy(retired.object);
+	}
+	return reclaimed.size();
+}
+
+//_____________________________________________________________________________
+//
+size_t AUEpochDomain::RetiredCount() const
+{
+	const std::lock_guard lock{ mRetiredMutex };
+	return mRetired.size();
+}
+
+//_____________________________________________________________________________
+//
+void AUEpochDomain::StartReclaimer(std::chrono::milliseconds interval)
+{
+	StopReclaimer();
+	mReclaimerStopping = false;
+	mReclaimer = std::thread{ [this, interval] {
+		std::unique_lock lock{ mReclaimerMutex };
+		const auto stopping = [this] { return mReclaimerStopping; };
+		while (!mReclaimerWakeup.wait_for(lock, interval, stopping)) {
+			lock.unlock();
+			Reclaim();
+			lock.lock();
+		}
+		lock.unlock();
+		Reclaim();
+	} };
+}
+
+//_____________________________________________________________________________
+//
+void AUEpochDomain::StopReclaimer()
+{
+	if (!mReclaimer.joinable()) {
+		return;
+	}
+	{
+		const std::lock_guard lock{ mReclaimerMutex };
+		mReclaimerStopping = true;
+	}
+	mReclaimerWakeup.notify_one();
+	mReclaimer.join();
+}
+
+} // namespace ausdk
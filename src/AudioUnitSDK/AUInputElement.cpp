@@ -32,12 +32,14 @@ void AUInputElement::SetConnection(const AudioUnitConnection& conn)
 
 	mInputType = EInputType::FromConnection;
 	mConnection = conn;
+	mPullCached = false;
 	AllocateBuffer();
 }
 
 void AUInputElement::Disconnect()
 {
 	mInputType = EInputType::NoInput;
+	mPullCached = false;
 	IOBuffer().Deallocate();
 }
 
@@ -54,6 +56,7 @@ void AUInputElement::SetInputCallback(AURenderCallback proc, void* refCon)
 		mInputType = EInputType::FromCallback;
 		mInputProc = proc;
 		mInputProcRefCon = refCon;
+		mPullCached = false;
 		AllocateBuffer();
 	}
 }
@@ -62,6 +65,7 @@ OSStatus AUInputElement::SetStreamFormat(const AudioStreamBasicDescription& fmt)
 {
 	const OSStatus err = AUIOElement::SetStreamFormat(fmt);
 	if (err == noErr) {
+		mPullCached = false;
 		AllocateBuffer();
 	}
 	return err;
@@ -72,13 +76,31 @@ OSStatus AUInputElement::PullInput(AudioUnitRenderActionFlags& ioActionFlags,
 {
 	AUSDK_Require(IsActive(), kAudioUnitErr_NoConnection);
 
+	const bool cacheable =
+		mCachesPulls && (inTimeStamp.mFlags & kAudioTimeStampSampleTimeValid) != 0;
+	if (cacheable && mPullCached && inTimeStamp.mSampleTime == mCachedSampleTime &&
+		nFrames == mCachedFrames) {
+		ioActionFlags |= mCachedSilence;
+		mPullCacheHits.fetch_add(1, std::memory_order_relaxed);
+		return noErr;
+	}
+
 	auto& iob = IOBuffer();
 
 	AudioBufferList& pullBuffer = (HasConnection() || !WillAllocateBuffer())
 									  ? iob.PrepareNullBuffer(GetStreamFormat(), nFrames)
 									  : iob.PrepareBuffer(GetStreamFormat(), nFrames);
 
-	return PullInputWithBufferList(ioActionFlags, inTimeStamp, inElement, nFrames, pullBuffer);
+	const OSStatus result =
+		PullInputWithBufferList(ioActionFlags, inTimeStamp, inElement, nFrames, pullBuffer);
+	mPullCached = cacheable && result == noErr;
+	if (cacheable) {
+		mCachedSampleTime = inTimeStamp.mSampleTime;
+		mCachedFrames = nFrames;
+		mCachedSilence = ioActionFlags & kAudioUnitRenderAction_OutputIsSilence;
+		mPullCacheMisses.fetch_add(1, std::memory_order_relaxed);
+	}
+	return result;
 }
 
 } // namespace ausdk
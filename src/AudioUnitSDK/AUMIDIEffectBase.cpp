@@ -11,43 +11,11 @@ AUMIDIEffectBase::AUMIDIEffectBase(AudioComponentInstance inInstance, bool inPro
 {
 }
 
-OSStatus AUMIDIEffectBase::GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
-	AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable)
+const AUPropertyRegistry& AUMIDIEffectBase::GetPropertyRegistry() const
 {
-	OSStatus result =
-		AUEffectBase::GetPropertyInfo(inID, inScope, inElement, outDataSize, outWritable);
-
-	if (result == kAudioUnitErr_InvalidProperty) {
-		result =
-			AUMIDIBase::DelegateGetPropertyInfo(inID, inScope, inElement, outDataSize, outWritable);
-	}
-
-	return result;
-}
-
-OSStatus AUMIDIEffectBase::GetProperty(
-	AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement, void* outData)
-{
-	OSStatus result = AUEffectBase::GetProperty(inID, inScope, inElement, outData);
-
-	if (result == kAudioUnitErr_InvalidProperty) {
-		result = AUMIDIBase::DelegateGetProperty(inID, inScope, inElement, outData);
-	}
-
-	return result;
-}
-
-OSStatus AUMIDIEffectBase::SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-	AudioUnitElement inElement, const void* inData, UInt32 inDataSize)
-{
-
-	OSStatus result = AUEffectBase::SetProperty(inID, inScope, inElement, inData, inDataSize);
-
-	if (result == kAudioUnitErr_InvalidProperty) {
-		result = AUMIDIBase::DelegateSetProperty(inID, inScope, inElement, inData, inDataSize);
-	}
-
-	return result;
+	static const AUPropertyRegistry registry =
+		MakePropertyRegistry<AUMIDIEffectBase>(AUEffectBase::GetPropertyRegistry());
+	return registry;
 }
 
 } // namespace ausdk
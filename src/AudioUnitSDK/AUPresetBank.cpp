@@ -0,0 +1,208 @@
+/*!
+	@file		AudioUnitSDK/AUPresetBank.cpp
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#include <AudioUnitSDK/AUPresetBank.h>
+#include <AudioUnitSDK/AUUtility.h>
+
+#include <algorithm>
+#include <ranges>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ausdk {
+
+//_____________________________________________________________________________
+//
+AUPresetBank::AUPresetBank(const char* path)
+{
+	const int fd = open(path, O_RDONLY | O_CLOEXEC); // NOLINT vararg
+	ThrowExceptionIf(fd < 0, kAudioUnitErr_InvalidFile);
+	struct stat info {};
+	void* mapping = MAP_FAILED; // NOLINT cast
+	if (fstat(fd, &info) == 0 && info.st_size > 0) {
+		mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd); // the mapping keeps the file open
+	ThrowExceptionIf(mapping == MAP_FAILED, kAudioUnitErr_InvalidFile); // NOLINT cast
+
+	mMapping = mapping;
+	mData = std::span(static_cast<const UInt8*>(mapping), static_cast<size_t>(info.st_size));
+	try {
+		Open();
+	} catch (...) {
+		munmap(mMapping, mData.size());
+		throw;
+	}
+}
+
+//_____________________________________________________________________________
+//
+AUPresetBank::AUPresetBank(std::span<const UInt8> data) : mData{ data } { Open(); }
+
+//_____________________________________________________________________________
+//
+AUPresetBank::~AUPresetBank()
+{
+	if (mMapping != nullptr) {
+		munmap(mMapping, mData.size());
+	}
+}
+
+//_____________________________________________________________________________
+//
+//	Only the header is checked here, so that opening is O(1); the index entries are
+//	validated as they are used.
+//
+void AUPresetBank::Open()
+{
+	ThrowExceptionIf(mData.size() < kHeaderSize, kAudioUnitErr_InvalidFile);
+	AUBinaryStateReader reader{ mData };
+	ThrowExceptionIf(reader.ReadUInt32() != kMagic, kAudioUnitErr_InvalidFile);
+	ThrowExceptionIf(reader.ReadUInt32() != kVersion, kAudioUnitErr_InvalidFile);
+	mCount = reader.ReadUInt32();
+	ThrowExceptionIf(
+		mCount > (mData.size() - kHeaderSize) / kIndexEntrySize, kAudioUnitErr_InvalidFile);
+}
+
+//_____________________________________________________________________________
+//
+AUPresetBank::IndexEntry AUPresetBank::EntryAt(size_t index) const
+{
+	ThrowExceptionIf(index >= mCount, kAudio_ParamError);
+	AUBinaryStateReader reader{ mData.subspan(kHeaderSize + (index * kIndexEntrySize)) };
+	const auto number = static_cast<SInt32>(reader.ReadUInt32());
+	const auto bytesAt = [&](UInt32 offset, UInt32 size) {
+		ThrowExceptionIf(offset > mData.size() || size > mData.size() - offset,
+			kAudioUnitErr_InvalidFile);
+		return mData.subspan(offset, size);
+	};
+	const auto nameOffset = reader.ReadUInt32();
+	const auto name = bytesAt(nameOffset, reader.ReadUInt32());
+	const auto stateOffset = reader.ReadUInt32();
+	const auto state = bytesAt(stateOffset, reader.ReadUInt32());
+	return { .number = number, .name = name, .state = state };
+}
+
+//_____________________________________________________________________________
+//
+std::optional<size_t> AUPresetBank::Find(SInt32 number) const
+{
+	if (number >= 0 && static_cast<size_t>(number) < mCount &&
+		NumberAt(static_cast<size_t>(number)) == number) {
+		return static_cast<size_t>(number);
+	}
+	const auto indices = std::views::iota(size_t{ 0 }, mCount);
+	const auto found = std::ranges::lower_bound(
+		indices, number, std::less{}, [this](size_t index) { return NumberAt(index); });
+	if (found != indices.end() && NumberAt(*found) == number) {
+		return *found;
+	}
+	return std::nullopt;
+}
+
+//_____________________________________________________________________________
+//
+SInt32 AUPresetBank::NumberAt(size_t index) const
+{
+	ThrowExceptionIf(index >= mCount, kAudio_ParamError);
+	AUBinaryStateReader reader{ mData.subspan(kHeaderSize + (index * kIndexEntrySize)) };
+	return static_cast<SInt32>(reader.ReadUInt32());
+}
+
+//_____________________________________________________________________________
+//
+Owned<CFStringRef> AUPresetBank::NameAt(size_t index) const
+{
+	const auto name = EntryAt(index).name;
+	return Owned<CFStringRef>::from_create(CFStringCreateWithBytes(nullptr, name.data(),
+		static_cast<CFIndex>(name.size()), kCFStringEncodingUTF8, false));
+}
+
+//_____________________________________________________________________________
+//
+Owned<CFDataRef> AUPresetBank::StateAt(size_t index) const
+{
+	const auto state = EntryAt(index).state;
+	return Owned<CFDataRef>::from_create(CFDataCreateWithBytesNoCopy(
+		nullptr, state.data(), static_cast<CFIndex>(state.size()), kCFAllocatorNull));
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUPresetBank::CopyPresets(CFArrayRef* outData) const
+{
+	if (outData == nullptr) {
+		return noErr;
+	}
+	std::call_once(mPresetsCreated, [this] {
+		mPresets.reserve(mCount);
+		mPresetNames.reserve(mCount);
+		for (size_t index = 0; index < mCount; ++index) {
+			mPresetNames.push_back(NameAt(index));
+			mPresets.push_back({ .presetNumber = NumberAt(index),
+				.presetName = *mPresetNames.back() });
+		}
+	});
+
+	std::vector<const void*> values(mPresets.size());
+	std::ranges::transform(
+		mPresets, values.begin(), [](const AUPreset& preset) { return &preset; });
+	*outData = CFArrayCreate(nullptr, values.data(), static_cast<CFIndex>(values.size()), nullptr);
+	return noErr;
+}
+
+//_____________________________________________________________________________
+//
+std::vector<UInt8> AUPresetBank::Encode(std::span<const Preset> presets)
+{
+	std::vector<const Preset*> sorted(presets.size());
+	std::ranges::transform(presets, sorted.begin(), [](const Preset& preset) { return &preset; });
+	std::ranges::stable_sort(sorted, std::less{}, &Preset::number);
+
+	std::vector<std::vector<UInt8>> names;
+	size_t size = kHeaderSize + (sorted.size() * kIndexEntrySize);
+	for (const Preset* preset : sorted) {
+		const auto range = CFRangeMake(0, CFStringGetLength(preset->name));
+		CFIndex nameSize = 0;
+		CFStringGetBytes(
+			preset->name, range, kCFStringEncodingUTF8, 0, false, nullptr, 0, &nameSize);
+		auto& name = names.emplace_back(static_cast<size_t>(nameSize));
+		CFStringGetBytes(preset->name, range, kCFStringEncodingUTF8, 0, false, name.data(),
+			nameSize, nullptr);
+		size += AUBinaryState::PaddedSize(name.size()) +
+				AUBinaryState::PaddedSize(static_cast<size_t>(CFDataGetLength(preset->state)));
+	}
+
+	std::vector<UInt8> bank(size);
+	AUBinaryStateWriter writer{ bank };
+	writer.WriteUInt32(kMagic);
+	writer.WriteUInt32(kVersion);
+	writer.WriteUInt32(static_cast<UInt32>(sorted.size()));
+	writer.WriteUInt32(0);
+	writer.Claim(sorted.size() * kIndexEntrySize); // the index, written below
+	for (size_t index = 0; index < sorted.size(); ++index) {
+		const auto nameOffset = writer.Size();
+		writer.WriteBytes(names[index]);
+		writer.Pad();
+		const auto stateOffset = writer.Size();
+		const auto stateSize = static_cast<size_t>(CFDataGetLength(sorted[index]->state));
+		writer.WriteBytes(std::span(CFDataGetBytePtr(sorted[index]->state), stateSize));
+		writer.Pad();
+
+		const std::array<UInt32, 5> entry{ static_cast<UInt32>(sorted[index]->number),
+			static_cast<UInt32>(nameOffset), static_cast<UInt32>(names[index].size()),
+			static_cast<UInt32>(stateOffset), static_cast<UInt32>(stateSize) };
+		for (size_t word = 0; word < entry.size(); ++word) {
+			writer.WriteAt(kHeaderSize + (index * kIndexEntrySize) +
+							   (word * AUBinaryState::kWordSize),
+				entry[word]);
+		}
+	}
+	return bank;
+}
+
+} // namespace ausdk
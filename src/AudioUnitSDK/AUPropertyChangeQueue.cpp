@@ -0,0 +1,139 @@
+/*!
+	@file		AudioUnitSDK/AUPropertyChangeQueue.cpp
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#include <AudioUnitSDK/AUPropertyChangeQueue.h>
+#include <AudioUnitSDK/AUUtility.h>
+
+namespace ausdk {
+
+//_____________________________________________________________________________
+//
+size_t AUPropertyChangeQueue::Hash(const Change& change) noexcept
+{
+	constexpr UInt32 kMultiplier = 0x9E3779B1u; // golden ratio
+	UInt32 hash = change.propertyID * kMultiplier;
+	hash = (hash ^ change.scope) * kMultiplier;
+	hash = (hash ^ change.element) * kMultiplier;
+	return hash >> 24u; // NOLINT magic number: the top 8 bits, for kCapacity
+}
+
+static_assert(AUPropertyChangeQueue::kCapacity == 256);
+
+//_____________________________________________________________________________
+//
+//	Finds the slot for the change by linear probing, claiming an empty one for a change not seen
+//	before. A slot being claimed by another thread is passed over rather than waited for, and a
+//	change's earlier slot may be further along than one freed since, so the same change may
+//	occasionally occupy two slots; it is then delivered once for each.
+//
+bool AUPropertyChangeQueue::Post(const Change& change) noexcept
+{
+	const size_t start = Hash(change);
+	for (size_t probe = 0; probe < kCapacity; ++probe) {
+		auto& slot = mSlots[(start + probe) % kCapacity];
+		auto word = slot.word.load(std::memory_order_acquire);
+		for (;;) { // until the slot is passed over, or the word is unchanged by other threads
+			const auto state = word & kStateMask;
+			if (state == kSlotEmpty) {
+				if (slot.word.compare_exchange_weak(word, SlotWord(word, kSlotClaimed),
+						std::memory_order_acquire, std::memory_order_acquire)) {
+					std::atomic_thread_fence(std::memory_order_release);
+					slot.propertyID.store(change.propertyID, std::memory_order_relaxed);
+					slot.scope.store(change.scope, std::memory_order_relaxed);
+					slot.element.store(change.element, std::memory_order_relaxed);
+					slot.word.store(SlotWord(word, kSlotPending), std::memory_order_release);
+					return true;
+				}
+				continue;
+			}
+			if (state == kSlotClaimed) {
+				break;
+			}
+			// The change read is only the slot's own if the word is still the same afterwards.
+			const bool matches = slot.Load() == change;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (!matches) {
+				if (slot.word.load(std::memory_order_relaxed) == word) {
+					break;
+				}
+				word = slot.word.load(std::memory_order_acquire);
+				continue;
+			}
+			if (slot.word.compare_exchange_weak(word, SlotWord(word, kSlotPending),
+					std::memory_order_release, std::memory_order_acquire)) {
+				return true;
+			}
+		}
+	}
+	mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+//_____________________________________________________________________________
+//
+//	Only Drain frees slots, so a delivered or pending slot's change is stable here.
+//
+size_t AUPropertyChangeQueue::Drain(const std::function<void(const Change&)>& deliver)
+{
+	size_t count = 0;
+	for (auto& slot : mSlots) {
+		auto word = slot.word.load(std::memory_order_acquire);
+		switch (word & kStateMask) {
+		case kSlotPending: {
+			const auto change = slot.Load();
+			// Marked delivered first, so that a change posted again meanwhile stays pending.
+			slot.word.store(SlotWord(word, kSlotDelivered), std::memory_order_release);
+			deliver(change);
+			++count;
+			break;
+		}
+		case kSlotDelivered:
+			// Not posted since the previous pass: free the slot, unless a Post takes it first.
+			slot.word.compare_exchange_strong(word,
+				SlotWord(word + kGenerationIncrement, kSlotEmpty), std::memory_order_acq_rel,
+				std::memory_order_relaxed);
+			break;
+		default:
+			break;
+		}
+	}
+	return count;
+}
+
+//_____________________________________________________________________________
+//
+void AUPropertyChangeQueue::StartDispatcher(
+	std::chrono::milliseconds interval, std::function<void(const Change&)> deliver)
+{
+	StopDispatcher();
+	mDispatcherStopping = false;
+	mDispatcher = std::thread{ [this, interval, deliver = std::move(deliver)] {
+		std::unique_lock lock{ mDispatcherMutex };
+		const auto stopping = [this] { return mDispatcherStopping; };
+		while (!mDispatcherWakeup.wait_for(lock, interval, stopping)) {
+			lock.unlock();
+			Drain(deliver);
+			lock.lock();
+		}
+		lock.unlock();
+		Drain(deliver);
+	} };
+}
+
+//_____________________________________________________________________________
+//
+void AUPropertyChangeQueue::StopDispatcher()
+{
+	if (!mDispatcher.joinable()) {
+		return;
+	}
+	{
+		const std::lock_guard lock{ mDispatcherMutex };
+		mDispatcherStopping = true;
+	}
+	mDispatcherWakeup.notify_one();
+	mDispatcher.join();
+}
+
+} // namespace ausdk
@@ -0,0 +1,129 @@
+/*!
+	@file		AudioUnitSDK/AUPropertyRegistry.cpp
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#include <AudioUnitSDK/AUPropertyRegistry.h>
+#include <AudioUnitSDK/AUUtility.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace ausdk {
+
+//_____________________________________________________________________________
+//
+AUPropertyRegistry::AUPropertyRegistry(std::span<const Handler> handlers) { Add(handlers); }
+
+//_____________________________________________________________________________
+//
+AUPropertyRegistry::AUPropertyRegistry(
+	const AUPropertyRegistry& base, std::span<const Handler> handlers)
+	: mHandlers{ base.mHandlers }
+{
+	Add(handlers);
+}
+
+//_____________________________________________________________________________
+//
+void AUPropertyRegistry::Add(std::span<const Handler> handlers)
+{
+	for (const auto& handler : handlers) {
+		const auto existing = std::ranges::lower_bound(mHandlers, handler.id, {}, &Handler::id);
+		if (existing != mHandlers.end() && existing->id == handler.id) {
+			*existing = handler;
+		} else {
+			mHandlers.insert(existing, handler);
+		}
+	}
+	ThrowExceptionIf(
+		mHandlers.size() >= std::numeric_limits<UInt16>::max(), kAudio_ParamError);
+
+	mDenseIndex.fill(0);
+	for (size_t index = 0; index < mHandlers.size(); ++index) {
+		if (mHandlers[index].id < kDenseIDCount) {
+			mDenseIndex[mHandlers[index].id] = static_cast<UInt16>(index + 1);
+		}
+	}
+}
+
+//_____________________________________________________________________________
+//
+const AUPropertyRegistry::Handler* AUPropertyRegistry::Find(
+	AudioUnitPropertyID inID) const noexcept
+{
+	if (inID < kDenseIDCount) {
+		const auto index = mDenseIndex[inID];
+		return index != 0 ? &mHandlers[index - 1u] : nullptr;
+	}
+	const auto found = std::ranges::lower_bound(mHandlers, inID, {}, &Handler::id);
+	return found != mHandlers.end() && found->id == inID ? &*found : nullptr;
+}
+
+//_____________________________________________________________________________
+//
+const AUPropertyRegistry::Handler* AUPropertyRegistry::FindInScope(
+	AudioUnitPropertyID inID, AudioUnitScope inScope, OSStatus& outError) const noexcept
+{
+	const auto* const handler = Find(inID);
+	if (handler == nullptr) {
+		outError = kAudioUnitErr_InvalidProperty;
+		return nullptr;
+	}
+	if ((handler->scopes & ScopeMask(inScope)) == 0u && handler->scopes != kAnyScope) {
+		outError = kAudioUnitErr_InvalidScope;
+		return nullptr;
+	}
+	outError = noErr;
+	return handler;
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUPropertyRegistry::GetPropertyInfo(AUBase& unit, AudioUnitPropertyID inID,
+	AudioUnitScope inScope, AudioUnitElement inElement, UInt32& outDataSize,
+	bool& outWritable) const
+{
+	OSStatus result = noErr;
+	const auto* const handler = FindInScope(inID, inScope, result);
+	if (handler == nullptr) {
+		return result;
+	}
+	if (handler->getInfo != nullptr) {
+		return handler->getInfo(unit, inID, inScope, inElement, outDataSize, outWritable);
+	}
+	outDataSize = handler->dataSize;
+	outWritable = handler->writable;
+	return noErr;
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUPropertyRegistry::GetProperty(AUBase& unit, AudioUnitPropertyID inID,
+	AudioUnitScope inScope, AudioUnitElement inElement, void* outData) const
+{
+	OSStatus result = noErr;
+	const auto* const handler = FindInScope(inID, inScope, result);
+	if (handler == nullptr) {
+		return result;
+	}
+	AUSDK_Require(handler->get != nullptr, kAudioUnitErr_InvalidProperty);
+	return handler->get(unit, inID, inScope, inElement, outData);
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUPropertyRegistry::SetProperty(AUBase& unit, AudioUnitPropertyID inID,
+	AudioUnitScope inScope, AudioUnitElement inElement, const void* inData,
+	UInt32 inDataSize) const
+{
+	OSStatus result = noErr;
+	const auto* const handler = FindInScope(inID, inScope, result);
+	if (handler == nullptr) {
+		return result;
+	}
+	AUSDK_Require(handler->set != nullptr, kAudioUnitErr_PropertyNotWritable);
+	AUSDK_Require(inDataSize >= handler->dataSize, kAudioUnitErr_InvalidPropertyValue);
+	return handler->set(unit, inID, inScope, inElement, inData, inDataSize);
+}
+
+} // namespace ausdk
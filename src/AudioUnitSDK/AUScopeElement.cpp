@@ -13,12 +13,31 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <cmath>
 #include <cstring>
 #include <numeric>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace ausdk {
 
+// The size of one parameter as written by AUElement::SaveState.
+constexpr size_t kSavedParameterSize =
+	sizeof(AudioUnitParameterID) + sizeof(AudioUnitParameterValue);
+
+static size_t RemainingStateBytes(const UInt8* p, const UInt8* end) noexcept
+{
+	return p < end ? static_cast<size_t>(end - p) : 0;
+}
+
+static UInt32 DeserializeBoundedBigUInt32AndAdvance(const UInt8*& ioData, const UInt8* end)
+{
+	ThrowExceptionIf(
+		RemainingStateBytes(ioData, end) < sizeof(UInt32), kAudioUnitErr_InvalidPropertyValue);
+	return DeserializeBigUInt32AndAdvance(ioData);
+}
+
 //_____________________________________________________________________________
 //
 //	By default, parameterIDs may be arbitrarily spaced, and a flat map
@@ -29,8 +48,35 @@ namespace ausdk {
 //
 void AUElement::UseIndexedParameters(UInt32 inNumberOfParameters)
 {
+	mParameterTable = {};
+	mParameterBlocks.clear();
+	mParameters.clear();
+	InvalidateParameterMetadata();
 	mIndexedParameters.resize(inNumberOfParameters);
 	mUseIndexedParameters = true;
+	ResizeChangeFlags(inNumberOfParameters);
+}
+
+//_____________________________________________________________________________
+//
+//	Calling UseParameterTable() backs the element's parameters with a perfect-hash
+//	index over a (typically constexpr) AUParameterTable, so that arbitrarily spaced
+//	paramIDs get constant-time access. Values start at the descriptors' defaults.
+//	Any indexed or map-backed parameters are discarded.
+//	Call this before defining/adding any parameters with SetParameter()
+//
+void AUElement::UseParameterTable(AUParameterTableView table)
+{
+	mUseIndexedParameters = false;
+	mIndexedParameters.clear();
+	mParameters.clear();
+	InvalidateParameterMetadata();
+	mParameterTable = table;
+	mParameterBlocks.assign((table.size() + kParametersPerBlock - 1) / kParametersPerBlock, {});
+	for (size_t i = 0; i < table.size(); ++i) {
+		TableValue(i).store(table[i].defaultValue, std::memory_order_release);
+	}
+	ResizeChangeFlags(table.size());
 }
 
 //_____________________________________________________________________________
@@ -40,6 +86,9 @@ void AUElement::UseIndexedParameters(UInt32 inNumberOfParameters)
 //
 bool AUElement::HasParameterID(AudioUnitParameterID paramID) const
 {
+	if (!mParameterTable.empty()) {
+		return mParameterTable.Contains(paramID);
+	}
 	if (mUseIndexedParameters) {
 		return paramID < mIndexedParameters.size();
 	}
@@ -53,6 +102,12 @@ bool AUElement::HasParameterID(AudioUnitParameterID paramID) const
 //
 AudioUnitParameterValue AUElement::GetParameter(AudioUnitParameterID paramID) const
 {
+	if (!mParameterTable.empty()) {
+		const auto index = mParameterTable.IndexOf(paramID);
+		ausdk::ThrowExceptionIf(
+			index == AUParameterTableView::npos, kAudioUnitErr_InvalidParameter);
+		return TableValue(index).load(std::memory_order_acquire);
+	}
 	if (mUseIndexedParameters) {
 		ausdk::ThrowExceptionIf(
 			paramID >= mIndexedParameters.size(), kAudioUnitErr_InvalidParameter);
@@ -68,10 +123,17 @@ AudioUnitParameterValue AUElement::GetParameter(AudioUnitParameterID paramID) co
 void AUElement::SetParameter(
 	AudioUnitParameterID paramID, AudioUnitParameterValue inValue, bool okWhenInitialized)
 {
-	if (mUseIndexedParameters) {
+	if (!mParameterTable.empty()) {
+		const auto index = mParameterTable.IndexOf(paramID);
+		ausdk::ThrowExceptionIf(
+			index == AUParameterTableView::npos, kAudioUnitErr_InvalidParameter);
+		TableValue(index).store(inValue, std::memory_order_release);
+		MarkChangedAtIndex(index);
+	} else if (mUseIndexedParameters) {
 		ausdk::ThrowExceptionIf(
 			paramID >= mIndexedParameters.size(), kAudioUnitErr_InvalidParameter);
 		mIndexedParameters[paramID].store(inValue, std::memory_order_release);
+		MarkChangedAtIndex(paramID);
 	} else {
 		const auto i = mParameters.find(paramID);
 
@@ -88,12 +150,285 @@ void AUElement::SetParameter(
 			} else {
 				// create new entry in map for the paramID (only happens first time)
 				mParameters[paramID] = ParameterValue{ inValue };
+				// map positions have shifted, so all change flags are re-raised
+				ResizeChangeFlags(mParameters.size());
 			}
 		} else {
 			// paramID already exists in map so simply change its value
 			i->second.store(inValue, std::memory_order_release);
+			MarkChangedAtIndex(static_cast<size_t>(std::distance(mParameters.begin(), i)));
+		}
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::SetParameters(std::span<const AUParameterIDValue> values, bool okWhenInitialized)
+{
+	// Resolve every ID before publishing anything, so that the transaction is all-or-nothing.
+	const bool canDefineParameters = !mUseIndexedParameters && mParameterTable.empty() &&
+									 (!mAudioUnit.IsInitialized() || okWhenInitialized);
+	const bool allDefined = std::ranges::all_of(values, [this](const AUParameterIDValue& item) {
+		return ParameterIndex(item.mParameterID) != kInvalidIndex;
+	});
+	if (!allDefined) {
+		ausdk::ThrowExceptionIf(!canDefineParameters, kAudioUnitErr_InvalidParameter);
+		// Defining parameters reshapes the map, which is never concurrent with readers anyway.
+		DefineParameters(values);
+		return;
+	}
+
+	StoreParameterTransaction(values, BeginParameterTransaction());
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::StoreParameterTransaction(
+	std::span<const AUParameterIDValue> values, UInt32 sequence)
+{
+	for (const auto& item : values) {
+		const auto index = ParameterIndex(item.mParameterID);
+		ValueAtIndex(index).store(item.mValue, std::memory_order_relaxed);
+		SetChangeFlag(index);
+	}
+	mParameterSequence.store(sequence + 2, std::memory_order_release);
+	mParameterGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//_____________________________________________________________________________
+//
+OSStatus AUElement::GetParameters(std::span<AUParameterIDValue> ioValues) const noexcept
+{
+	constexpr int kMaxAttempts = 4;
+	for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+		const auto sequence = mParameterSequence.load(std::memory_order_acquire);
+		for (auto& item : ioValues) {
+			const auto index = ParameterIndex(item.mParameterID);
+			if (index == kInvalidIndex) {
+				return kAudioUnitErr_InvalidParameter;
+			}
+			item.mValue = ValueAtIndex(index).load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if ((sequence & 1u) == 0 &&
+			mParameterSequence.load(std::memory_order_relaxed) == sequence) {
+			return noErr;
+		}
+	}
+	return kAudioUnitErr_CannotDoInCurrentContext;
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::GetParametersAtIndices(
+	std::span<const size_t> indices, std::span<AudioUnitParameterValue> values) const
+{
+	for (size_t i = 0; i < indices.size(); ++i) {
+		values[i] = ValueAtIndex(indices[i]).load(std::memory_order_acquire);
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::SetParametersAtIndices(
+	std::span<const size_t> indices, std::span<const AudioUnitParameterValue> values) noexcept
+{
+	StoreParametersAtIndices(indices, values, BeginParameterTransaction());
+}
+
+//_____________________________________________________________________________
+//
+bool AUElement::TrySetParametersAtIndices(
+	std::span<const size_t> indices, std::span<const AudioUnitParameterValue> values) noexcept
+{
+	UInt32 sequence = 0;
+	if (!TryBeginParameterTransaction(sequence)) {
+		return false;
+	}
+	StoreParametersAtIndices(indices, values, sequence);
+	return true;
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::StoreParametersAtIndices(std::span<const size_t> indices,
+	std::span<const AudioUnitParameterValue> values, UInt32 sequence) noexcept
+{
+	for (size_t i = 0; i < indices.size(); ++i) {
+		ValueAtIndex(indices[i]).store(values[i], std::memory_order_relaxed);
+		SetChangeFlag(indices[i]);
+	}
+	mParameterSequence.store(sequence + 2, std::memory_order_release);
+	mParameterGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//_____________________________________________________________________________
+//
+//	Writers take the sequence lock by moving it from even to odd. Transactions are
+//	short and never block, so a competing writer just yields until it is released.
+//
+UInt32 AUElement::BeginParameterTransaction() noexcept
+{
+	auto sequence = mParameterSequence.load(std::memory_order_relaxed);
+	for (;;) {
+		if ((sequence & 1u) != 0) {
+			std::this_thread::yield();
+			sequence = mParameterSequence.load(std::memory_order_relaxed);
+		} else if (mParameterSequence.compare_exchange_weak(sequence, sequence + 1,
+					   std::memory_order_acquire, std::memory_order_relaxed)) {
+			break;
+		}
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+	return sequence;
+}
+
+//_____________________________________________________________________________
+//
+bool AUElement::TryBeginParameterTransaction(UInt32& outSequence) noexcept
+{
+	auto sequence = mParameterSequence.load(std::memory_order_relaxed);
+	if ((sequence & 1u) != 0) {
+		return false;
+	}
+	if (!mParameterSequence.compare_exchange_strong(
+			sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+		return false;
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+	outSequence = sequence;
+	return true;
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::MarkParameterChanged(AudioUnitParameterID paramID)
+{
+	const auto index = ParameterIndex(paramID);
+	ausdk::ThrowExceptionIf(index == kInvalidIndex, kAudioUnitErr_InvalidParameter);
+	MarkChangedAtIndex(index);
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::MarkAllParametersChanged() noexcept
+{
+	const size_t numParams = ParameterCount();
+	for (size_t word = 0; word < mChangedParameters.size(); ++word) {
+		const size_t first = word * kChangeFlagsPerWord;
+		const size_t count = std::min(numParams - std::min(first, numParams), kChangeFlagsPerWord);
+		const UInt64 mask =
+			count == kChangeFlagsPerWord ? ~UInt64{ 0 } : (UInt64{ 1 } << count) - 1;
+		mChangedParameters[word].fetch_or(mask, std::memory_order_release);
+		mFedParameters[word].fetch_or(mask, std::memory_order_release);
+	}
+	mParameterGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//_____________________________________________________________________________
+//
+//	Not realtime-safe: called only when parameters are being defined.
+//
+void AUElement::ResizeChangeFlags(size_t numParameters)
+{
+	const size_t numWords = (numParameters + kChangeFlagsPerWord - 1) / kChangeFlagsPerWord;
+	mChangedParameters.resize(numWords);
+	mFedParameters.resize(numWords);
+	MarkAllParametersChanged();
+	InvalidateParameterMetadata(); // it and the state base are indexed by the same positions
+	mStateBase.clear();
+	mHasStateBase = false;
+}
+
+//_____________________________________________________________________________
+//
+//	Sorts the incoming values once and merges them into the map in a single pass,
+//	instead of shifting the map's storage for each new parameter.
+//
+void AUElement::DefineParameters(std::span<const AUParameterIDValue> values)
+{
+	std::vector<std::pair<AudioUnitParameterID, ParameterValue>> sorted;
+	sorted.reserve(values.size());
+	for (const auto& item : values) {
+		sorted.emplace_back(item.mParameterID, ParameterValue{ item.mValue });
+	}
+	std::ranges::stable_sort(sorted, {}, [](const auto& keyValue) { return keyValue.first; });
+
+	// Of duplicate IDs the last one wins, as with consecutive SetParameter calls.
+	auto out = sorted.begin();
+	for (auto in = sorted.begin(); in != sorted.end(); ++in) {
+		const auto next = std::next(in);
+		if (next == sorted.end() || next->first != in->first) {
+			*out++ = std::move(*in);
 		}
 	}
+	sorted.erase(out, sorted.end());
+
+	mParameters.insert_or_assign_sorted(sorted);
+	// map positions have shifted, so all change flags are re-raised
+	ResizeChangeFlags(mParameters.size());
+}
+
+//_____________________________________________________________________________
+//
+size_t AUElement::ParameterCount() const noexcept
+{
+	if (!mParameterTable.empty()) {
+		return mParameterTable.size();
+	}
+	return mUseIndexedParameters ? mIndexedParameters.size() : mParameters.size();
+}
+
+//_____________________________________________________________________________
+//
+size_t AUElement::ParameterIndex(AudioUnitParameterID paramID) const noexcept
+{
+	if (!mParameterTable.empty()) {
+		return mParameterTable.IndexOf(paramID);
+	}
+	if (mUseIndexedParameters) {
+		return paramID < mIndexedParameters.size() ? paramID : kInvalidIndex;
+	}
+	const auto i = mParameters.find(paramID);
+	return i != mParameters.end() ? static_cast<size_t>(std::distance(mParameters.begin(), i))
+								  : kInvalidIndex;
+}
+
+//_____________________________________________________________________________
+//
+AudioUnitParameterID AUElement::ParameterIDAtIndex(size_t index) const
+{
+	if (!mParameterTable.empty()) {
+		return mParameterTable[index].id;
+	}
+	if (mUseIndexedParameters) {
+		return static_cast<AudioUnitParameterID>(index);
+	}
+	return std::next(mParameters.begin(), static_cast<std::ptrdiff_t>(index))->first;
+}
+
+//_____________________________________________________________________________
+//
+const AUElement::ParameterValue& AUElement::ValueAtIndex(size_t index) const
+{
+	if (!mParameterTable.empty()) {
+		return TableValue(index);
+	}
+	if (mUseIndexedParameters) {
+		return mIndexedParameters[index];
+	}
+	return std::next(mParameters.begin(), static_cast<std::ptrdiff_t>(index))->second;
+}
+
+AUElement::ParameterValue& AUElement::ValueAtIndex(size_t index)
+{
+	if (!mParameterTable.empty()) {
+		return TableValue(index);
+	}
+	if (mUseIndexedParameters) {
+		return mIndexedParameters[index];
+	}
+	return std::next(mParameters.begin(), static_cast<std::ptrdiff_t>(index))->second;
 }
 
 //_____________________________________________________________________________
@@ -115,7 +450,9 @@ void AUElement::SetScheduledEvent(AudioUnitParameterID paramID,
 //
 void AUElement::GetParameterList(AudioUnitParameterID* outList)
 {
-	if (mUseIndexedParameters) {
+	if (!mParameterTable.empty()) {
+		std::ranges::transform(mParameterTable.Descriptors(), outList, &AUParameterDescriptor::id);
+	} else if (mUseIndexedParameters) {
 		const auto numParams = std::ssize(mIndexedParameters);
 		std::iota(outList, std::next(outList, numParams), 0);
 	} else {
@@ -126,81 +463,224 @@ void AUElement::GetParameterList(AudioUnitParameterID* outList)
 
 //_____________________________________________________________________________
 //
-static void AppendBytes(CFMutableDataRef data, const TriviallyCopySerializable auto& value)
+std::optional<AUElement::ParameterMetadata> AUElement::CopyParameterMetadata(
+	AudioUnitScope scope, AudioUnitParameterID paramID)
 {
-	CFDataAppendBytes(data, reinterpret_cast<const UInt8*>(&value), sizeof(value)); // NOLINT
+	const auto metadata = PrepareParameterMetadata(scope);
+	const auto index = ParameterIndex(paramID);
+	if (metadata == nullptr || index >= metadata->entries.size()) {
+		return std::nullopt;
+	}
+	ParameterMetadata copy = metadata->entries[index];
+	if (copy.status == noErr && (copy.info.flags & kAudioUnitParameterFlag_CFNameRelease) != 0u) {
+		// the client releases its copy of the names; the cache keeps its own references
+		if (copy.info.cfNameString != nullptr) {
+			CFRetain(copy.info.cfNameString);
+		}
+		if (copy.info.unit == kAudioUnitParameterUnit_CustomUnit && copy.info.unitName != nullptr) {
+			CFRetain(copy.info.unitName);
+		}
+	}
+	return copy;
 }
 
 //_____________________________________________________________________________
 //
-void AUElement::SaveState(AudioUnitScope scope, CFMutableDataRef data)
+//	The metadata is only cached once the unit is initialized, since parameters
+//	(and their info) are typically still being defined before then. Elements of
+//	extended scopes are not cached: AUBase has no way to invalidate them.
+//
+//	The cache is rebuilt outside the lock, so that the unit's GetParameterInfo never
+//	runs under it; concurrent rebuilds are harmless, and the last one installed wins.
+//	A cache built while it was being invalidated records the older generation, and is
+//	rebuilt again by its next user.
+//
+std::shared_ptr<const AUElement::ParameterMetadataCache> AUElement::PrepareParameterMetadata(
+	AudioUnitScope scope)
 {
-	AudioUnitParameterInfo paramInfo{};
-	const auto countOffset = CFDataGetLength(data);
-	uint32_t paramsWritten = 0;
+	if (!mAudioUnit.IsInitialized() || scope > kAudioUnitScope_Group) {
+		return nullptr;
+	}
+	const auto generation = mParameterMetadataGeneration.load(std::memory_order_acquire);
+	const size_t numParams = ParameterCount();
+	{
+		const std::lock_guard lock{ mParameterMetadataMutex };
+		if (mParameterMetadata != nullptr && mParameterMetadata->generation == generation &&
+			mParameterMetadata->entries.size() == numParams) {
+			return mParameterMetadata;
+		}
+	}
 
-	const auto appendParameter = [&](AudioUnitParameterID paramID, AudioUnitParameterValue value) {
-		if (mAudioUnit.GetParameterInfo(scope, paramID, paramInfo) == noErr) {
-			if ((paramInfo.flags & kAudioUnitParameterFlag_CFNameRelease) != 0u) {
-				if (paramInfo.cfNameString != nullptr) {
-					CFRelease(paramInfo.cfNameString);
-				}
-				if (paramInfo.unit == kAudioUnitParameterUnit_CustomUnit &&
-					paramInfo.unitName != nullptr) {
-					CFRelease(paramInfo.unitName);
-				}
+	auto metadata = std::make_shared<ParameterMetadataCache>();
+	metadata->generation = generation;
+	metadata->entries.resize(numParams);
+	for (size_t i = 0; i < numParams; ++i) {
+		auto& [info, status] = metadata->entries[i];
+		status = mAudioUnit.GetParameterInfo(scope, ParameterIDAtIndex(i), info);
+		if (status == noErr && (info.flags & kAudioUnitParameterFlag_CFNameRelease) != 0u) {
+			// take ownership of the names; they are retained again for each client which copies
+			// the info with the flag set
+			if (info.cfNameString != nullptr) {
+				metadata->names.push_back(Owned<CFStringRef>::from_create(info.cfNameString));
 			}
-			if (((paramInfo.flags & kAudioUnitParameterFlag_OmitFromPresets) != 0u) ||
-				((paramInfo.flags & kAudioUnitParameterFlag_MeterReadOnly) != 0u)) {
-				return;
+			if (info.unit == kAudioUnitParameterUnit_CustomUnit && info.unitName != nullptr) {
+				metadata->names.push_back(Owned<CFStringRef>::from_create(info.unitName));
 			}
 		}
+	}
 
-		AppendBytes(data, CFSwapInt32HostToBig(paramID));
-		AppendBytes(data, CFSwapInt32HostToBig(std::bit_cast<UInt32>(value)));
+	std::shared_ptr<const ParameterMetadataCache> stale;
+	{
+		const std::lock_guard lock{ mParameterMetadataMutex };
+		stale = std::exchange(mParameterMetadata, metadata);
+	}
+	return metadata; // the stale cache, if this held its last reference, is freed here
+}
 
-		++paramsWritten;
-	};
+//_____________________________________________________________________________
+//
+static void AppendBytes(CFMutableDataRef data, const TriviallyCopySerializable auto& value)
+{
+	CFDataAppendBytes(data, reinterpret_cast<const UInt8*>(&value), sizeof(value)); // NOLINT
+}
 
-	constexpr UInt32 placeholderCount = 0;
-	AppendBytes(data, placeholderCount);
+//_____________________________________________________________________________
+//
+void AUElement::SaveState(AudioUnitScope scope, CFMutableDataRef data)
+{
+	// Reserve room for every parameter up front and write the entries in place.
+	constexpr auto entrySize = sizeof(AudioUnitParameterID) + sizeof(AudioUnitParameterValue);
+	const auto countOffset = CFDataGetLength(data);
+	const auto entriesOffset = countOffset + static_cast<CFIndex>(sizeof(UInt32));
+	CFDataSetLength(data, entriesOffset + static_cast<CFIndex>(ParameterCount() * entrySize));
+	UInt8* const entries = CFDataGetMutableBytePtr(data) + entriesOffset; // NOLINT ptr math
+	uint32_t paramsWritten = 0;
 
-	if (mUseIndexedParameters) {
-		const auto numParams = static_cast<UInt32>(mIndexedParameters.size());
-		for (UInt32 i = 0; i < numParams; i++) {
-			appendParameter(i, mIndexedParameters[i]);
-		}
-	} else {
-		for (const auto& item : mParameters) {
-			appendParameter(item.first, item.second);
-		}
-	}
+	ForEachSavedParameter(scope, [&](AudioUnitParameterID paramID, AudioUnitParameterValue value) {
+		const std::array<UInt32, 2> entry{ CFSwapInt32HostToBig(paramID),
+			CFSwapInt32HostToBig(std::bit_cast<UInt32>(value)) };
+		memcpy(entries + (paramsWritten * entrySize), entry.data(), entrySize); // NOLINT
+		++paramsWritten;
+	});
 
 	const auto count_BE = CFSwapInt32HostToBig(paramsWritten);
 	memcpy(CFDataGetMutableBytePtr(data) + countOffset, // NOLINT ptr math
 		&count_BE, sizeof(count_BE));
+	CFDataSetLength(data, entriesOffset + static_cast<CFIndex>(paramsWritten * entrySize));
 }
 
 //_____________________________________________________________________________
 //
-const UInt8* AUElement::RestoreState(const UInt8* state)
+bool AUElement::IsOmittedFromState(AudioUnitScope scope, const ParameterMetadataCache* metadata,
+	size_t index, AudioUnitParameterID paramID)
 {
-	const UInt8* p = state;
-	const auto numParams = DeserializeBigUInt32AndAdvance(p);
+	constexpr auto omitFlags = AudioUnitParameterOptions{ kAudioUnitParameterFlag_OmitFromPresets |
+														  kAudioUnitParameterFlag_MeterReadOnly };
+	if (metadata != nullptr) {
+		const auto& [info, status] = metadata->entries[index];
+		return status == noErr && (info.flags & omitFlags) != 0u;
+	}
 
-	for (UInt32 i = 0; i < numParams; ++i) {
-		const auto parameterID = DeserializeBigUInt32AndAdvance(p);
-		const auto valueBytes = DeserializeBigUInt32AndAdvance(p);
-		const auto value = std::bit_cast<AudioUnitParameterValue>(valueBytes);
+	AudioUnitParameterInfo paramInfo{};
+	if (mAudioUnit.GetParameterInfo(scope, paramID, paramInfo) != noErr) {
+		return false;
+	}
+	if ((paramInfo.flags & kAudioUnitParameterFlag_CFNameRelease) != 0u) {
+		if (paramInfo.cfNameString != nullptr) {
+			CFRelease(paramInfo.cfNameString);
+		}
+		if (paramInfo.unit == kAudioUnitParameterUnit_CustomUnit && paramInfo.unitName != nullptr) {
+			CFRelease(paramInfo.unitName);
+		}
+	}
+	return (paramInfo.flags & omitFlags) != 0u;
+}
 
-		SetParameter(parameterID, value);
+//_____________________________________________________________________________
+//
+//	The parameter count comes from the saved data, so it is checked against the bytes which are
+//	actually there before it sizes anything.
+//
+const UInt8* AUElement::RestoreState(const UInt8* state, const UInt8* end)
+{
+	const UInt8* p = state;
+	const auto numParams = DeserializeBoundedBigUInt32AndAdvance(p, end);
+	ausdk::ThrowExceptionIf(numParams > RemainingStateBytes(p, end) / kSavedParameterSize,
+		kAudioUnitErr_InvalidPropertyValue);
+
+	std::vector<AUParameterIDValue> values(numParams);
+	for (auto& item : values) {
+		item.mParameterID = DeserializeBigUInt32AndAdvance(p);
+		item.mValue = std::bit_cast<AudioUnitParameterValue>(DeserializeBigUInt32AndAdvance(p));
 	}
+	RestoreParameters(values);
 	return p;
 }
 
 //_____________________________________________________________________________
 //
-AUIOElement::AUIOElement(AUBase& audioUnit) : AUElement(audioUnit), mWillAllocate(true)
+void AUElement::RestoreParameters(std::vector<AUParameterIDValue>& values)
+{
+	if (mParameterTable.empty() && !mUseIndexedParameters && !mAudioUnit.IsInitialized()) {
+		DefineParameters(values);
+		return;
+	}
+	// As in SetParameter, undefined parameters are ignored once initialized, and always by a
+	// table-backed or indexed element, which cannot define them.
+	std::erase_if(values, [this](const AUParameterIDValue& item) {
+		if (ParameterIndex(item.mParameterID) != kInvalidIndex) {
+			return false;
+		}
+		AUSDK_LogError("Warning: %s RestoreState for undefined param ID %u. Ignoring.",
+			mAudioUnit.GetLoggingString(), static_cast<unsigned>(item.mParameterID));
+		return true;
+	});
+	if (AUParameterSnapshot* const snapshot = mAudioUnit.GetRestoringParameterSnapshot()) {
+		snapshot->Add(*this, values);
+		return;
+	}
+	SetParameters(values);
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::AppendStateBase(
+	AudioUnitScope scope, bool fromDefaults, std::vector<AUParameterIDValue>& values)
+{
+	const auto metadata = PrepareParameterMetadata(scope);
+	const size_t numParams = ParameterCount();
+	for (size_t i = 0; i < numParams; ++i) {
+		const auto paramID = ParameterIDAtIndex(i);
+		if (IsOmittedFromState(scope, metadata.get(), i, paramID)) {
+			continue;
+		}
+		if (const auto base = StateBaseAtIndex(i, metadata.get(), fromDefaults)) {
+			values.push_back({ paramID, *base });
+		}
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUElement::CommitStateBase(std::span<const AUParameterIDValue> pending)
+{
+	const size_t numParams = ParameterCount();
+	mStateBase.resize(numParams);
+	for (size_t i = 0; i < numParams; ++i) {
+		mStateBase[i] = ValueAtIndex(i).load(std::memory_order_acquire);
+	}
+	for (const auto& item : pending) {
+		if (const auto index = ParameterIndex(item.mParameterID); index != kInvalidIndex) {
+			mStateBase[index] = item.mValue;
+		}
+	}
+	mHasStateBase = true;
+}
+
+//_____________________________________________________________________________
+//
+AUIOElement::AUIOElement(AUBase& audioUnit)
+	: AUElement(audioUnit), mWillAllocate(true), mMeters(audioUnit.GetRenderEpochDomain())
 {
 	mStreamFormat = AudioStreamBasicDescription{ .mSampleRate = AUBase::kAUDefaultSampleRate,
 		.mFormatID = kAudioFormatLinearPCM,
@@ -226,9 +706,191 @@ OSStatus AUIOElement::SetStreamFormat(const AudioStreamBasicDescription& format)
 		RemoveAudioChannelLayout();
 	}
 
+	if (IsMeteringEnabled()) {
+		SetMeteringEnabled(true); // for the new number of channels
+	}
 	return noErr;
 }
 
+//_____________________________________________________________________________
+//
+void AUIOElement::SetMeteringEnabled(bool inEnabled)
+{
+	const std::lock_guard lock{ mMetersMutex };
+	mMeters.Publish(inEnabled ? std::make_unique<MeterBank>(NumberChannels()) : nullptr);
+}
+
+namespace {
+
+struct ChannelLevels {
+	Float32 peak{ 0.f };
+	Float32 sumOfSquares{ 0.f };
+	UInt32 clipCount{ 0 };
+};
+
+// GCC and Clang vector extensions, which compile to NEON or SSE.
+using Float32x4 = Float32 __attribute__((vector_size(16)));
+using SInt32x4 = SInt32 __attribute__((vector_size(16)));
+
+ChannelLevels MeasureContiguous(const Float32* samples, size_t count) noexcept
+{
+	constexpr SInt32 kMagnitudeMask = 0x7FFFFFFF;
+	constexpr SInt32x4 magnitudeMask = { kMagnitudeMask, kMagnitudeMask, kMagnitudeMask,
+		kMagnitudeMask };
+	constexpr Float32x4 clipLevel = { 1.f, 1.f, 1.f, 1.f };
+	Float32x4 peak{};
+	Float32x4 sumOfSquares{};
+	SInt32x4 clipCount{};
+
+	size_t index = 0;
+	for (; index + 4 <= count; index += 4) {
+		Float32x4 x{};
+		std::memcpy(&x, samples + index, sizeof(x)); // NOLINT pointer arithmetic
+		const auto magnitude = (Float32x4)((SInt32x4)x & magnitudeMask); // NOLINT cast
+		const SInt32x4 louder = magnitude > peak;
+		// NOLINTNEXTLINE cast
+		peak = (Float32x4)(((SInt32x4)magnitude & louder) | ((SInt32x4)peak & ~louder));
+		sumOfSquares += x * x;
+		clipCount -= magnitude > clipLevel; // each true comparison is -1
+	}
+
+	ChannelLevels levels;
+	for (int lane = 0; lane < 4; ++lane) {
+		levels.peak = std::max(levels.peak, peak[lane]);
+		levels.sumOfSquares += sumOfSquares[lane];
+		levels.clipCount += static_cast<UInt32>(clipCount[lane]);
+	}
+	for (; index < count; ++index) {
+		const Float32 x = samples[index]; // NOLINT pointer arithmetic
+		levels.peak = std::max(levels.peak, std::abs(x));
+		levels.sumOfSquares += x * x;
+		levels.clipCount += std::abs(x) > 1.f ? 1u : 0u;
+	}
+	return levels;
+}
+
+ChannelLevels MeasureStrided(const Float32* samples, size_t count, size_t stride) noexcept
+{
+	ChannelLevels levels;
+	for (size_t frame = 0; frame < count; ++frame) {
+		const Float32 x = samples[frame * stride]; // NOLINT pointer arithmetic
+		levels.peak = std::max(levels.peak, std::abs(x));
+		levels.sumOfSquares += x * x;
+		levels.clipCount += std::abs(x) > 1.f ? 1u : 0u;
+	}
+	return levels;
+}
+
+} // namespace
+
+//_____________________________________________________________________________
+//
+void AUIOElement::Meter(const AudioBufferList& inBufferList, UInt32 inFrames) noexcept
+{
+	MeterBank* const bank = mMeters.Get();
+	if (bank == nullptr || mStreamFormat.mFormatID != kAudioFormatLinearPCM ||
+		(mStreamFormat.mFormatFlags & kLinearPCMFormatFlagIsFloat) == 0 ||
+		mStreamFormat.mBitsPerChannel != 32) { // NOLINT magic number
+		return;
+	}
+	const UInt32 channelsPerBuffer = std::max(NumberInterleavedChannels(), 1u);
+	size_t channel = 0;
+	const std::span buffers(inBufferList.mBuffers, inBufferList.mNumberBuffers); // NOLINT
+	for (const AudioBuffer& buffer : buffers) {
+		const auto* const samples = static_cast<const Float32*>(buffer.mData);
+		const size_t frames = std::min<size_t>(
+			inFrames, buffer.mDataByteSize / (sizeof(Float32) * channelsPerBuffer));
+		for (UInt32 i = 0; i < channelsPerBuffer && channel < bank->channels.size();
+			 ++i, ++channel) {
+			if (samples == nullptr) {
+				continue;
+			}
+			const auto levels = channelsPerBuffer == 1
+									? MeasureContiguous(samples, frames)
+									: MeasureStrided(samples + i, frames, channelsPerBuffer);
+			auto& meter = bank->channels[channel];
+			Float32 peak = meter.peak.load(std::memory_order_relaxed);
+			while (levels.peak > peak && !meter.peak.compare_exchange_weak(
+											 peak, levels.peak, std::memory_order_relaxed)) {
+			}
+			const Float32 meanSquare =
+				frames > 0 ? levels.sumOfSquares / static_cast<Float32>(frames) : 0.f;
+			meter.rms.store(std::sqrt(meanSquare), std::memory_order_relaxed);
+			meter.clipCount.fetch_add(levels.clipCount, std::memory_order_relaxed);
+		}
+	}
+}
+
+//_____________________________________________________________________________
+//
+//	Scans blocks of kBlockSize samples, comparing the magnitudes against the threshold four at a
+//	time, and stops at the end of the first block containing a louder sample. A NaN is never
+//	at or below the threshold, so it counts as louder. Interleaved buffers are scanned as one run
+//	of samples, since which channel a sample belongs to does not matter.
+//
+bool AUIOElement::IsBelowThreshold(
+	const AudioBufferList& inBufferList, UInt32 inFrames, Float32 inThreshold) const noexcept
+{
+	if (mStreamFormat.mFormatID != kAudioFormatLinearPCM ||
+		(mStreamFormat.mFormatFlags & kLinearPCMFormatFlagIsFloat) == 0 ||
+		mStreamFormat.mBitsPerChannel != 32) { // NOLINT magic number
+		return false;
+	}
+	constexpr size_t kBlockSize = 64;
+	constexpr SInt32 kMagnitudeMask = 0x7FFFFFFF;
+	constexpr SInt32x4 magnitudeMask = { kMagnitudeMask, kMagnitudeMask, kMagnitudeMask,
+		kMagnitudeMask };
+	const Float32x4 threshold = { inThreshold, inThreshold, inThreshold, inThreshold };
+	const UInt32 channelsPerBuffer = std::max(NumberInterleavedChannels(), 1u);
+	const std::span buffers(inBufferList.mBuffers, inBufferList.mNumberBuffers); // NOLINT
+	for (const AudioBuffer& buffer : buffers) {
+		const auto* const samples = static_cast<const Float32*>(buffer.mData);
+		if (samples == nullptr) {
+			continue;
+		}
+		const size_t count =
+			std::min<size_t>(static_cast<size_t>(inFrames) * channelsPerBuffer,
+				buffer.mDataByteSize / sizeof(Float32));
+		size_t index = 0;
+		while (index + kBlockSize <= count) {
+			SInt32x4 louder{};
+			for (const size_t end = index + kBlockSize; index < end; index += 4) {
+				Float32x4 x{};
+				std::memcpy(&x, samples + index, sizeof(x)); // NOLINT pointer arithmetic
+				louder |= ~((Float32x4)((SInt32x4)x & magnitudeMask) <= threshold); // NOLINT cast
+			}
+			if ((louder[0] | louder[1] | louder[2] | louder[3]) != 0) {
+				return false;
+			}
+		}
+		for (; index < count; ++index) {
+			if (!(std::abs(samples[index]) <= inThreshold)) { // NOLINT pointer arithmetic
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+//_____________________________________________________________________________
+//
+size_t AUIOElement::ReadMeters(std::span<AUChannelMeterValues> outValues)
+{
+	const std::lock_guard lock{ mMetersMutex }; // so that the bank is not retired meanwhile
+	MeterBank* const bank = mMeters.Get();
+	if (bank == nullptr) {
+		return 0;
+	}
+	const size_t count = std::min(outValues.size(), bank->channels.size());
+	for (size_t channel = 0; channel < count; ++channel) {
+		auto& meter = bank->channels[channel];
+		outValues[channel] = { .mPeak = meter.peak.exchange(0.f, std::memory_order_relaxed),
+			.mRMS = meter.rms.load(std::memory_order_relaxed),
+			.mClipCount = meter.clipCount.load(std::memory_order_relaxed) };
+	}
+	return count;
+}
+
 //_____________________________________________________________________________
 // inFramesToAllocate == 0 implies the AudioUnit's max-frames-per-slice will be used
 void AUIOElement::AllocateBuffer(UInt32 inFramesToAllocate)
@@ -396,20 +1058,47 @@ void AUScope::SaveState(CFMutableDataRef data) const
 	}
 }
 
-const UInt8* AUScope::RestoreState(const UInt8* state) const
+const UInt8* AUScope::RestoreState(const UInt8* state, const UInt8* end) const
 {
 	const UInt8* p = state;
-	const auto elementIdx = DeserializeBigUInt32AndAdvance(p);
+	const auto elementIdx = DeserializeBoundedBigUInt32AndAdvance(p, end);
 	AUElement* const element = GetElement(elementIdx);
 	if (element == nullptr) {
-		const auto numParams = DeserializeBigUInt32AndAdvance(p);
-		constexpr auto entrySize = sizeof(AudioUnitParameterID) + sizeof(AudioUnitParameterValue);
-		p += numParams * entrySize; // NOLINT
+		const auto numParams = DeserializeBoundedBigUInt32AndAdvance(p, end);
+		ausdk::ThrowExceptionIf(numParams > RemainingStateBytes(p, end) / kSavedParameterSize,
+			kAudioUnitErr_InvalidPropertyValue);
+		p += numParams * kSavedParameterSize; // NOLINT
 	} else {
-		p = element->RestoreState(p);
+		p = element->RestoreState(p, end);
 	}
 
 	return p;
 }
 
+//_____________________________________________________________________________
+//
+std::optional<AUElement::ParameterMetadata> AUScope::CopyParameterMetadata(
+	AudioUnitParameterID paramID) const
+{
+	for (UInt32 i = 0; i < GetNumberOfElements(); ++i) {
+		AUElement* const el = GetElement(i);
+		if ((el != nullptr) && el->HasParameterID(paramID)) {
+			return el->CopyParameterMetadata(mScope, paramID);
+		}
+	}
+	return std::nullopt;
+}
+
+//_____________________________________________________________________________
+//
+void AUScope::InvalidateParameterMetadata() const
+{
+	for (UInt32 i = 0; i < GetNumberOfElements(); ++i) {
+		AUElement* const el = GetElement(i);
+		if (el != nullptr) {
+			el->InvalidateParameterMetadata();
+		}
+	}
+}
+
 } // namespace ausdk
@@ -0,0 +1,222 @@
+/*!
+	@file		AudioUnitSDK/AUWorkerPool.cpp
+	@copyright	© 2000-2024 Apple Inc. All rights reserved.
+*/
+#include <AudioUnitSDK/AUWorkerPool.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#include <mach/thread_policy.h>
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+
+namespace ausdk {
+
+//_____________________________________________________________________________
+//
+//	Gives the calling thread the time-constraint policy which Core Audio gives I/O threads:
+//	up to half of each render period of computation, to be done within the period. The period
+//	is kept within what the kernel accepts.
+//
+static void SetRealTimeScheduling(std::chrono::nanoseconds renderPeriod) noexcept
+{
+#if defined(__APPLE__)
+	using namespace std::chrono_literals;
+	renderPeriod = std::clamp<std::chrono::nanoseconds>(renderPeriod, 1ms, 100ms);
+	mach_timebase_info_data_t timebase{};
+	mach_timebase_info(&timebase);
+	const auto toAbsolute = [&timebase](std::chrono::nanoseconds duration) {
+		return static_cast<uint32_t>(static_cast<UInt64>(duration.count()) * timebase.denom /
+									 timebase.numer);
+	};
+	thread_time_constraint_policy_data_t policy{ .period = toAbsolute(renderPeriod),
+		.computation = toAbsolute(renderPeriod / 2),
+		.constraint = toAbsolute(renderPeriod),
+		.preemptible = 1 };
+	const auto result = thread_policy_set(pthread_mach_thread_np(pthread_self()),
+		THREAD_TIME_CONSTRAINT_POLICY,
+		reinterpret_cast<thread_policy_t>(&policy), // NOLINT
+		THREAD_TIME_CONSTRAINT_POLICY_COUNT);
+	if (result != KERN_SUCCESS) {
+		AUSDK_LogError("AUWorkerPool: thread_policy_set failed: %d", result);
+	}
+#else
+	static_cast<void>(renderPeriod);
+#endif
+}
+
+//_____________________________________________________________________________
+//
+//	Tells the processor that the caller is spinning, without giving up the thread.
+//
+static inline void SpinPause() noexcept
+{
+#if defined(__arm64__) || defined(__aarch64__)
+	__builtin_arm_yield();
+#elif defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#endif
+}
+
+//_____________________________________________________________________________
+//
+//	A Mach semaphore is signaled by a trap into the kernel rather than under a user-space lock,
+//	which a thread of lower priority might hold.
+//
+AUWorkerPool::Semaphore::Semaphore()
+{
+#if defined(__APPLE__)
+	const auto result = semaphore_create(mach_task_self(), &mSemaphore, SYNC_POLICY_FIFO, 0);
+	ThrowExceptionIf(result != KERN_SUCCESS, kAudio_MemFullError);
+#endif
+}
+
+//_____________________________________________________________________________
+//
+AUWorkerPool::Semaphore::~Semaphore()
+{
+#if defined(__APPLE__)
+	semaphore_destroy(mach_task_self(), mSemaphore);
+#endif
+}
+
+//_____________________________________________________________________________
+//
+void AUWorkerPool::Semaphore::Signal() noexcept
+{
+#if defined(__APPLE__)
+	semaphore_signal(mSemaphore);
+#else
+	mSemaphore.release();
+#endif
+}
+
+//_____________________________________________________________________________
+//
+void AUWorkerPool::Semaphore::Wait() noexcept
+{
+#if defined(__APPLE__)
+	while (semaphore_wait(mSemaphore) == KERN_ABORTED) {
+	}
+#else
+	mSemaphore.acquire();
+#endif
+}
+
+//_____________________________________________________________________________
+//
+AUWorkerPool::AUWorkerPool(UInt32 threadCount, std::chrono::nanoseconds renderPeriod)
+{
+	mThreads.reserve(threadCount);
+	for (UInt32 i = 0; i < threadCount; ++i) {
+		mThreads.emplace_back([this, renderPeriod] { WorkerLoop(renderPeriod); });
+	}
+}
+
+//_____________________________________________________________________________
+//
+AUWorkerPool::~AUWorkerPool()
+{
+	mStopping.store(true);
+	for (size_t i = 0; i < mThreads.size(); ++i) {
+		mWakeup.Signal();
+	}
+	for (auto& thread : mThreads) {
+		thread.join();
+	}
+}
+
+//_____________________________________________________________________________
+//
+bool AUWorkerPool::Run(size_t count, Task task, void* context) noexcept
+{
+	if (count == 0) {
+		return true;
+	}
+	mTask = task;
+	mContext = context;
+	mPending.store(count, std::memory_order_relaxed);
+	const UInt64 generation = (mJob.load(std::memory_order_relaxed) >> kGenerationShift) + 1;
+	mJob.store((generation << kGenerationShift) | (UInt64{ count } << kCountShift),
+		std::memory_order_release);
+
+	// The caller takes a task too, so wake no more workers than there are other tasks, nor
+	// more than are not already to be woken.
+	const size_t helpers = std::min(mThreads.size(), count - 1);
+	size_t wakeups = mWakeups.load(std::memory_order_relaxed);
+	size_t toWake{};
+	do {
+		toWake = std::min(helpers, mThreads.size() - wakeups);
+	} while (toWake > 0 &&
+			 !mWakeups.compare_exchange_weak(wakeups, wakeups + toWake, std::memory_order_relaxed));
+	for (size_t i = 0; i < toWake; ++i) {
+		mWakeup.Signal();
+	}
+	// Every task which no worker has started yet is run here, rather than waited for.
+	while (RunOne()) {
+	}
+	// Only tasks already running on workers remain, which are as urgent as this thread; giving
+	// it up could only let lower-priority threads in, unless they run for long.
+	for (UInt32 spins = 0; mPending.load(std::memory_order_acquire) != 0; ++spins) {
+		if (spins == kMaxSpins) {
+			WaitForWorkers();
+			return false;
+		}
+		SpinPause();
+	}
+	return true;
+}
+
+//_____________________________________________________________________________
+//
+bool AUWorkerPool::RunOne() noexcept
+{
+	UInt64 job = mJob.load(std::memory_order_acquire);
+	do {
+		if ((job & kIndexMask) >= ((job >> kCountShift) & kIndexMask)) {
+			return false;
+		}
+	} while (!mJob.compare_exchange_weak(job, job + 1, std::memory_order_acq_rel));
+
+	// the claimed task keeps the job, and so mTask and mContext, from changing
+	mTask(mContext, static_cast<size_t>(job & kIndexMask));
+	// sequentially consistent, as is WaitForWorkers(), so that exactly one of the last task and
+	// a sleeping caller sees the other
+	if (mPending.fetch_sub(1) == 1 && mCallerWaiting.exchange(false)) {
+		mFinished.Signal();
+	}
+	return true;
+}
+
+//_____________________________________________________________________________
+//
+void AUWorkerPool::WaitForWorkers() noexcept
+{
+	mCallerWaiting.store(true);
+	// If the last task finished before it could see the flag, take the flag back; if it took
+	// the flag, it signals.
+	if (mPending.load() != 0 || !mCallerWaiting.exchange(false)) {
+		mFinished.Wait();
+	}
+}
+
+//_____________________________________________________________________________
+//
+void AUWorkerPool::WorkerLoop(std::chrono::nanoseconds renderPeriod) noexcept
+{
+	SetRealTimeScheduling(renderPeriod);
+	for (;;) {
+		mWakeup.Wait();
+		if (mStopping.load()) {
+			return;
+		}
+		mWakeups.fetch_sub(1, std::memory_order_relaxed);
+		while (RunOne()) {
+		}
+	}
+}
+
+} // namespace ausdk
@@ -11,6 +11,8 @@
 
 #include <AudioToolbox/MusicDevice.h>
 
+#include <array>
+
 namespace ausdk {
 
 
@@ -20,62 +22,21 @@ MusicDeviceBase::MusicDeviceBase(
 {
 }
 
-OSStatus MusicDeviceBase::GetPropertyInfo(AudioUnitPropertyID inID, AudioUnitScope inScope,
-	AudioUnitElement inElement, UInt32& outDataSize, bool& outWritable)
-{
-	switch (inID) { // NOLINT if/else
-	case kMusicDeviceProperty_InstrumentCount:
-		AUSDK_Require(inScope == kAudioUnitScope_Global, kAudioUnitErr_InvalidScope);
-		outDataSize = sizeof(UInt32);
-		outWritable = false;
-		return noErr;
-	default: {
-		auto result = AUBase::GetPropertyInfo(inID, inScope, inElement, outDataSize, outWritable);
-
-		if (result == kAudioUnitErr_InvalidProperty) {
-			result = AUMIDIBase::DelegateGetPropertyInfo(
-				inID, inScope, inElement, outDataSize, outWritable);
-		}
-		return result;
-	}
-	}
-}
-
-OSStatus MusicDeviceBase::GetProperty(
-	AudioUnitPropertyID inID, AudioUnitScope inScope, AudioUnitElement inElement, void* outData)
-{
-	switch (inID) { // NOLINT if/else
-	case kMusicDeviceProperty_InstrumentCount: {
-		AUSDK_Require(inScope == kAudioUnitScope_Global, kAudioUnitErr_InvalidScope);
-		UInt32 instrumentCount{};
-		const auto result = GetInstrumentCount(instrumentCount);
-		Serialize(instrumentCount, outData);
-		return result;
-	}
-	default: {
-		auto result = AUBase::GetProperty(inID, inScope, inElement, outData);
-
-		if (result == kAudioUnitErr_InvalidProperty) {
-			result = AUMIDIBase::DelegateGetProperty(inID, inScope, inElement, outData);
-		}
-		return result;
-	}
-	}
-}
-
-
-OSStatus MusicDeviceBase::SetProperty(AudioUnitPropertyID inID, AudioUnitScope inScope,
-	AudioUnitElement inElement, const void* inData, UInt32 inDataSize)
-
+const AUPropertyRegistry& MusicDeviceBase::GetPropertyRegistry() const
 {
-
-	OSStatus result = AUBase::SetProperty(inID, inScope, inElement, inData, inDataSize);
-
-	if (result == kAudioUnitErr_InvalidProperty) {
-		result = AUMIDIBase::DelegateSetProperty(inID, inScope, inElement, inData, inDataSize);
-	}
-
-	return result;
+	static const AUPropertyRegistry registry{
+		MakePropertyRegistry<MusicDeviceBase>(AUBase::GetPropertyRegistry()),
+		std::array{ AUPropertyRegistry::Handler{ .id = kMusicDeviceProperty_InstrumentCount,
+			.dataSize = sizeof(UInt32),
+			.get = [](AUBase& unit, AudioUnitPropertyID, AudioUnitScope, AudioUnitElement,
+					   void* outData) -> OSStatus {
+				UInt32 instrumentCount{};
+				const auto result =
+					static_cast<MusicDeviceBase&>(unit).GetInstrumentCount(instrumentCount);
+				Serialize(instrumentCount, outData);
+				return result;
+			} } } };
+	return registry;
 }
 
 // For a MusicDevice that doesn't support separate instruments (ie. is mono-timbral)
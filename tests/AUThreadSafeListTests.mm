@@ -7,6 +7,9 @@
 #include <AudioUnitSDK/AUThreadSafeList.h>
 #include <AudioUnitSDK/AudioUnitSDK.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -20,6 +23,167 @@ public:
 	uint32_t mValue{ 0 };
 };
 
+struct FauxRenderCallbackHash {
+	size_t operator()(const FauxRenderCallback& cb) const noexcept { return cb.mValue; }
+};
+
+// Producer threads each add and remove their own callbacks while this thread updates and
+// iterates the list, as a render thread would.
+template <typename List>
+static void RunContention(List& list, uint32_t producerCount)
+{
+	constexpr uint32_t kRequestsPerProducer = 2000;
+	constexpr uint32_t kCallbacksPerProducer = 8;
+	std::atomic<uint32_t> running{ producerCount };
+	std::vector<std::thread> producers;
+	for (uint32_t p = 0; p < producerCount; ++p) {
+		producers.emplace_back([&list, &running, p] {
+			for (uint32_t i = 0; i < kRequestsPerProducer; ++i) {
+				FauxRenderCallback cb;
+				cb.mValue = (p * kCallbacksPerProducer) + (i % kCallbacksPerProducer);
+				if ((i / kCallbacksPerProducer) % 2 == 0) {
+					while (!list.Add(cb)) {
+						std::this_thread::yield(); // a bounded list is full until the next Update
+					}
+				} else {
+					list.Remove(cb);
+				}
+			}
+			running.fetch_sub(1);
+		});
+	}
+	uint32_t sum = 0;
+	while (running.load() != 0) {
+		list.Update();
+		for (const auto& cb : list) {
+			sum += cb.mValue;
+		}
+	}
+	for (auto& producer : producers) {
+		producer.join();
+	}
+	list.Update();
+	XCTAssertEqual(std::ranges::distance(list), 0);
+	(void)sum;
+}
+
+// AUThreadSafeList::Add returns nothing; adapt it to RunContention.
+class UnboundedContentionList : public ausdk::AUThreadSafeList<FauxRenderCallback> {
+public:
+	bool Add(const FauxRenderCallback& cb)
+	{
+		AUThreadSafeList::Add(cb);
+		return true;
+	}
+};
+
+using BoundedList = ausdk::AUBoundedThreadSafeList<FauxRenderCallback, 16, FauxRenderCallbackHash>;
+using BoundedContentionList =
+	ausdk::AUBoundedThreadSafeList<FauxRenderCallback, 1024, FauxRenderCallbackHash>;
+
+class StackNode {
+public:
+	StackNode* mNext{ nullptr };
+	uint32_t mPops{ 0 };
+
+	StackNode*& Next() { return mNext; }
+};
+
+// Each thread repeatedly pops an element and pushes it back, counting its successful pops. With
+// AUAtomicStack, PopAtomic pops all the elements and pushes back the rest.
+template <typename Stack>
+static uint32_t RunStackContention(Stack& stack, uint32_t threadCount)
+{
+	constexpr uint32_t kIterations = 20000;
+	std::atomic<uint32_t> pops{ 0 };
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&stack, &pops] {
+			uint32_t threadPops = 0;
+			for (uint32_t i = 0; i < kIterations; ++i) {
+				if (StackNode* const node = stack.PopAtomic()) {
+					++node->mPops;
+					++threadPops;
+					stack.PushAtomic(node);
+				}
+			}
+			pops.fetch_add(threadPops);
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	return pops.load();
+}
+
+// A stack of 64 elements, for the benchmarks.
+template <typename Stack>
+struct StackFixture {
+	StackFixture()
+	{
+		for (auto& node : nodes) {
+			stack.PushNonAtomic(&node);
+		}
+	}
+
+	std::array<StackNode, 64> nodes;
+	Stack stack;
+};
+
+using AtomicStackFixture = StackFixture<ausdk::AUAtomicStack<StackNode>>;
+using TaggedAtomicStackFixture = StackFixture<ausdk::AUTaggedAtomicStack<StackNode>>;
+
+struct RingMessage {
+	uint32_t producer{ 0 };
+	uint32_t sequence{ 0 };
+};
+
+// Producers push kRingMessages messages each, in batches, while this thread pops them; returns
+// false if any producer's messages arrive out of order.
+template <typename Ring>
+static bool RunRingThroughput(Ring& ring, uint32_t producerCount)
+{
+	static constexpr uint32_t kRingMessages = 200000;
+	static constexpr size_t kBatchSize = 16;
+	std::vector<std::thread> producers;
+	for (uint32_t p = 0; p < producerCount; ++p) {
+		producers.emplace_back([&ring, p] {
+			std::array<RingMessage, kBatchSize> batch{};
+			for (uint32_t sent = 0; sent < kRingMessages;) {
+				const auto count = std::min<size_t>(kBatchSize, kRingMessages - sent);
+				for (size_t i = 0; i < count; ++i) {
+					batch[i] = { p, sent + static_cast<uint32_t>(i) };
+				}
+				const auto pushed = ring.Push(std::span(batch).first(count));
+				if (pushed == 0) {
+					std::this_thread::yield();
+				}
+				sent += static_cast<uint32_t>(pushed);
+			}
+		});
+	}
+	std::vector<uint32_t> expected(producerCount);
+	bool inOrder = true;
+	std::array<RingMessage, kBatchSize> batch{};
+	for (uint64_t received = 0; received < uint64_t{ kRingMessages } * producerCount;) {
+		const size_t count = ring.Pop(std::span(batch));
+		if (count == 0) {
+			std::this_thread::yield();
+		}
+		for (size_t i = 0; i < count; ++i) {
+			inOrder = inOrder && batch[i].sequence == expected[batch[i].producer]++;
+		}
+		received += count;
+	}
+	for (auto& producer : producers) {
+		producer.join();
+	}
+	return inOrder;
+}
+
+using SPSCRing = ausdk::AUSPSCRingBuffer<RingMessage, 1024>;
+using MPSCRing = ausdk::AUMPSCRingBuffer<RingMessage, 1024>;
+
 @interface AUThreadSafeListTests : XCTestCase
 
 @end
@@ -267,4 +431,307 @@ public:
 	XCTAssertEqual(std::ranges::distance(list), 0);
 }
 
+- (void)testBoundedList
+{
+	BoundedList list;
+	FauxRenderCallback cb;
+
+	// duplicates are ignored, and order is kept
+	for (uint32_t i = 0; i < 10; ++i) {
+		cb.mValue = i % 5;
+		XCTAssertTrue(list.Add(cb));
+	}
+	XCTAssertEqual(list.begin(), list.end());
+	list.Update();
+	std::vector<uint32_t> values;
+	std::ranges::transform(list, std::back_inserter(values), &FauxRenderCallback::mValue);
+	XCTAssertTrue((values == std::vector<uint32_t>{ 0, 1, 2, 3, 4 }));
+
+	cb.mValue = 2;
+	list.Remove(cb);
+	cb.mValue = 7;
+	list.Remove(cb);
+	list.Update();
+	values.clear();
+	std::ranges::transform(list, std::back_inserter(values), &FauxRenderCallback::mValue);
+	XCTAssertTrue((values == std::vector<uint32_t>{ 0, 1, 3, 4 }));
+
+	// requests for a value already queued take no further node, nor do removals of absent values
+	for (uint32_t i = 0; i < 1000; ++i) {
+		cb.mValue = 100;
+		XCTAssertTrue(list.Add(cb));
+		list.Remove(cb);
+		cb.mValue = 200 + i;
+		list.Remove(cb);
+	}
+	cb.mValue = 0;
+	list.Remove(cb);
+	XCTAssertTrue(list.Add(cb));
+	list.Update();
+	values.clear();
+	std::ranges::transform(list, std::back_inserter(values), &FauxRenderCallback::mValue);
+	XCTAssertTrue((values == std::vector<uint32_t>{ 0, 1, 3, 4 }));
+
+	// a removed value keeps its node until the next Update
+	for (uint32_t i = 0; i < 12; ++i) {
+		cb.mValue = 100 + i;
+		XCTAssertTrue(list.Add(cb));
+	}
+	cb.mValue = 300;
+	XCTAssertFalse(list.Add(cb));
+	list.Clear();
+	XCTAssertFalse(list.Add(cb));
+	list.Update();
+	XCTAssertEqual(list.begin(), list.end());
+
+	for (uint32_t i = 0; i < 16; ++i) {
+		cb.mValue = i;
+		XCTAssertTrue(list.Add(cb));
+	}
+	cb.mValue = 16;
+	XCTAssertFalse(list.Add(cb));
+	list.Update();
+	XCTAssertEqual(std::ranges::distance(list), 16);
+	cb.mValue = 3;
+	list.Remove(cb);
+	list.Update();
+	cb.mValue = 16;
+	XCTAssertTrue(list.Add(cb));
+	list.Update();
+	values.clear();
+	std::ranges::transform(list, std::back_inserter(values), &FauxRenderCallback::mValue);
+	XCTAssertTrue((values == std::vector<uint32_t>{ 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+		15, 16 }));
+}
+
+- (void)testBoundedListConsistency
+{
+	constexpr uint32_t kTestElements = 10000;
+	using List =
+		ausdk::AUBoundedThreadSafeList<FauxRenderCallback, kTestElements, FauxRenderCallbackHash>;
+	auto list = std::make_unique<List>();
+
+	std::vector<uint32_t> mirrorState;
+	FauxRenderCallback cb;
+	for (uint32_t i = 0; i < kTestElements; ++i) {
+		cb.mValue = i;
+		XCTAssertTrue(list->Add(cb));
+		mirrorState.push_back(i);
+	}
+	list->Update();
+	for (uint32_t i = 0; i < kTestElements; i += 7) {
+		cb.mValue = i;
+		list->Remove(cb);
+		std::erase(mirrorState, i);
+	}
+	list->Update();
+
+	std::vector<uint32_t> values;
+	std::ranges::transform(*list, std::back_inserter(values), &FauxRenderCallback::mValue);
+	XCTAssertTrue(std::ranges::equal(values, mirrorState));
+}
+
+// XCTest measures once per test method, so each producer count has its own.
+- (void)testContentionOneProducerPerformance
+{
+	[self measureBlock:^{
+		UnboundedContentionList list;
+		RunContention(list, 1);
+	}];
+}
+
+- (void)testContentionManyProducersPerformance
+{
+	[self measureBlock:^{
+		UnboundedContentionList list;
+		RunContention(list, 16);
+	}];
+}
+
+- (void)testBoundedContentionOneProducerPerformance
+{
+	[self measureBlock:^{
+		BoundedContentionList list;
+		RunContention(list, 1);
+	}];
+}
+
+- (void)testBoundedContentionManyProducersPerformance
+{
+	[self measureBlock:^{
+		BoundedContentionList list;
+		RunContention(list, 16);
+	}];
+}
+
+- (void)testTaggedAtomicStack
+{
+	constexpr uint32_t kNodeCount = 64;
+	std::vector<StackNode> nodes(kNodeCount);
+	ausdk::AUTaggedAtomicStack<StackNode> stack;
+	for (auto& node : nodes) {
+		stack.PushAtomic(&node);
+	}
+	const uint32_t pops = RunStackContention(stack, 8);
+
+	// every element is back, once, and each pop was of an element no other thread held
+	std::vector<StackNode*> popped;
+	while (StackNode* const node = stack.PopAtomic()) {
+		popped.push_back(node);
+	}
+	XCTAssertTrue(stack.empty());
+	XCTAssertEqual(popped.size(), kNodeCount);
+	std::ranges::sort(popped);
+	XCTAssertEqual(std::ranges::unique(popped).begin(), popped.end());
+	uint32_t counted = 0;
+	for (const auto& node : nodes) {
+		counted += node.mPops;
+	}
+	XCTAssertEqual(counted, pops);
+
+	// a chain is pushed without being traversed, and pops as a unit
+	nodes[0].mNext = &nodes[1];
+	nodes[1].mNext = nullptr;
+	stack.PushMultipleAtomic(&nodes[0], &nodes[1]);
+	XCTAssertEqual(stack.PopAll(), &nodes[0]);
+	XCTAssertEqual(stack.PopAll(), nullptr);
+}
+
+- (void)testAtomicStackOneThreadPerformance
+{
+	const auto fixture = std::make_unique<AtomicStackFixture>();
+	auto* const stack = &fixture->stack;
+	[self measureBlock:^{
+		RunStackContention(*stack, 1);
+	}];
+}
+
+- (void)testAtomicStackEightThreadsPerformance
+{
+	const auto fixture = std::make_unique<AtomicStackFixture>();
+	auto* const stack = &fixture->stack;
+	[self measureBlock:^{
+		RunStackContention(*stack, 8);
+	}];
+}
+
+- (void)testAtomicStackThirtyTwoThreadsPerformance
+{
+	const auto fixture = std::make_unique<AtomicStackFixture>();
+	auto* const stack = &fixture->stack;
+	[self measureBlock:^{
+		RunStackContention(*stack, 32);
+	}];
+}
+
+- (void)testTaggedAtomicStackOneThreadPerformance
+{
+	const auto fixture = std::make_unique<TaggedAtomicStackFixture>();
+	auto* const stack = &fixture->stack;
+	[self measureBlock:^{
+		RunStackContention(*stack, 1);
+	}];
+}
+
+- (void)testTaggedAtomicStackEightThreadsPerformance
+{
+	const auto fixture = std::make_unique<TaggedAtomicStackFixture>();
+	auto* const stack = &fixture->stack;
+	[self measureBlock:^{
+		RunStackContention(*stack, 8);
+	}];
+}
+
+- (void)testTaggedAtomicStackThirtyTwoThreadsPerformance
+{
+	const auto fixture = std::make_unique<TaggedAtomicStackFixture>();
+	auto* const stack = &fixture->stack;
+	[self measureBlock:^{
+		RunStackContention(*stack, 32);
+	}];
+}
+
+- (void)testRingBuffers
+{
+	// members of a unit, which is constructed in storage which is only 16-byte aligned
+	static_assert(alignof(ausdk::AUSPSCRingBuffer<uint32_t, 8>) <= 16);
+	static_assert(alignof(ausdk::AUMPSCRingBuffer<uint32_t, 8>) <= 16);
+
+	const auto spsc = std::make_unique<ausdk::AUSPSCRingBuffer<uint32_t, 8>>();
+	const auto mpsc = std::make_unique<ausdk::AUMPSCRingBuffer<uint32_t, 8>>();
+	const auto check = [](auto& ring) {
+		const std::array<uint32_t, 6> values{ 1, 2, 3, 4, 5, 6 };
+		std::array<uint32_t, 6> popped{};
+		uint32_t value = 0;
+		XCTAssertFalse(ring.Pop(value));
+		XCTAssertEqual(ring.Push(std::span(values)), 6u);
+		XCTAssertEqual(ring.Pop(std::span(popped).first(4)), 4u);
+		// wraps around, and pushes only what fits
+		XCTAssertEqual(ring.Push(std::span(values)), 6u);
+		XCTAssertEqual(ring.Push(std::span(values)), 0u);
+		XCTAssertFalse(ring.Push(7u));
+		XCTAssertEqual(ring.Size(), 8u);
+		XCTAssertEqual(ring.Pop(std::span(popped)), 6u);
+		XCTAssertTrue((popped == std::array<uint32_t, 6>{ 5, 6, 1, 2, 3, 4 }));
+		XCTAssertTrue(ring.Pop(value));
+		XCTAssertTrue(ring.Pop(value));
+		XCTAssertEqual(value, 6u);
+		XCTAssertFalse(ring.Pop(value));
+	};
+	check(*spsc);
+	check(*mpsc);
+
+	const auto spscMessages = std::make_unique<SPSCRing>();
+	XCTAssertTrue(RunRingThroughput(*spscMessages, 1));
+	const auto mpscMessages = std::make_unique<MPSCRing>();
+	XCTAssertTrue(RunRingThroughput(*mpscMessages, 4));
+}
+
+- (void)testSPSCRingThroughputPerformance
+{
+	const auto ring = std::make_unique<SPSCRing>();
+	auto* const ringPtr = ring.get();
+	[self measureBlock:^{
+		RunRingThroughput(*ringPtr, 1);
+	}];
+}
+
+- (void)testMPSCRingThroughputPerformance
+{
+	const auto ring = std::make_unique<MPSCRing>();
+	auto* const ringPtr = ring.get();
+	[self measureBlock:^{
+		RunRingThroughput(*ringPtr, 4);
+	}];
+}
+
+// Round trips of one message between two threads, through a ring in each direction.
+- (void)testSPSCRingLatencyPerformance
+{
+	constexpr uint32_t kRoundTrips = 20000;
+	const auto request = std::make_unique<ausdk::AUSPSCRingBuffer<uint32_t, 64>>();
+	const auto reply = std::make_unique<ausdk::AUSPSCRingBuffer<uint32_t, 64>>();
+	auto* const requests = request.get();
+	auto* const replies = reply.get();
+	[self measureBlock:^{
+		std::thread echo([requests, replies] {
+			uint32_t value = 0;
+			for (uint32_t i = 0; i < kRoundTrips; ++i) {
+				while (!requests->Pop(value)) {
+					std::this_thread::yield();
+				}
+				replies->Push(value);
+			}
+		});
+		uint32_t value = 0;
+		for (uint32_t i = 0; i < kRoundTrips; ++i) {
+			requests->Push(i);
+			while (!replies->Pop(value)) {
+				std::this_thread::yield();
+			}
+		}
+		echo.join();
+	}];
+}
+
 @end
@@ -8,10 +8,14 @@
 #import <AudioUnitSDK/AudioUnitSDK.h>
 #import <algorithm>
 #import <array>
+#import <cmath>
 #import <cstddef>
 #import <cstring>
+#import <limits>
 #import <memory>
+#import <numeric>
 #import <span>
+#import <thread>
 #import <vector>
 
 @interface Tests : XCTestCase
@@ -48,6 +52,108 @@
 	XCTAssertEqual(uut[15], 15.0);
 }
 
+- (void)testFlatMapInsertSorted
+{
+	ausdk::flat_map<AudioUnitParameterID, float> uut;
+	uut[2] = 2.0;
+	uut[6] = 6.0;
+
+	const std::array<std::pair<AudioUnitParameterID, float>, 4> items{
+		{ { 1, 1.0 }, { 2, 2.5 }, { 4, 4.0 }, { 9, 9.0 } }
+	};
+	uut.insert_or_assign_sorted(items);
+	XCTAssertEqual(uut.size(), 5u);
+	XCTAssertEqual(uut[1], 1.0);
+	XCTAssertEqual(uut[2], 2.5);
+	XCTAssertEqual(uut[4], 4.0);
+	XCTAssertEqual(uut[6], 6.0);
+	XCTAssertEqual(uut[9], 9.0);
+	XCTAssertTrue(std::ranges::is_sorted(uut, {}, [](const auto& item) { return item.first; }));
+
+	uut.insert_or_assign_sorted({});
+	XCTAssertEqual(uut.size(), 5u);
+}
+
+// The two benchmarks below compare defining many parameters one at a time (as RestoreState used
+// to) against sorting them once and merging them in.
+static std::vector<std::pair<AudioUnitParameterID, float>> MakeUnsortedParameters()
+{
+	constexpr AudioUnitParameterID kCount = 20000;
+	std::vector<std::pair<AudioUnitParameterID, float>> items;
+	items.reserve(kCount);
+	for (AudioUnitParameterID i = 0; i < kCount; ++i) {
+		items.emplace_back((i * 7919u) % kCount, static_cast<float>(i));
+	}
+	return items;
+}
+
+- (void)testFlatMapInsertPerformance
+{
+	const auto items = MakeUnsortedParameters();
+	[self measureBlock:^{
+		ausdk::flat_map<AudioUnitParameterID, float> uut;
+		for (const auto& [key, value] : items) {
+			uut[key] = value;
+		}
+		XCTAssertEqual(uut.size(), items.size());
+	}];
+}
+
+- (void)testFlatMapInsertSortedPerformance
+{
+	const auto items = MakeUnsortedParameters();
+	[self measureBlock:^{
+		ausdk::flat_map<AudioUnitParameterID, float> uut;
+		auto sorted = items;
+		std::ranges::sort(sorted, {}, [](const auto& item) { return item.first; });
+		uut.insert_or_assign_sorted(sorted);
+		XCTAssertEqual(uut.size(), items.size());
+	}];
+}
+
+- (void)testParameterTable
+{
+	using ausdk::AUParameterDescriptor;
+	using ausdk::AUParameterTableView;
+
+	static constexpr ausdk::AUParameterTable kTable{ std::array{
+		AUParameterDescriptor{ .id = 'gain', .minValue = -96.f, .maxValue = 24.f },
+		AUParameterDescriptor{ .id = 'freq',
+			.minValue = 20.f,
+			.maxValue = 20000.f,
+			.defaultValue = 1000.f,
+			.unit = kAudioUnitParameterUnit_Hertz },
+		AUParameterDescriptor{ .id = 0, .maxValue = 1.f },
+		AUParameterDescriptor{ .id = 1000, .maxValue = 1.f } } };
+
+	static_assert(kTable.IndexOf('gain') == 0);
+	static_assert(kTable.IndexOf('freq') == 1);
+	static_assert(kTable.IndexOf(0) == 2);
+	static_assert(kTable.IndexOf(1000) == 3);
+	static_assert(kTable.IndexOf(1) == AUParameterTableView::npos);
+
+	const AUParameterTableView view = kTable;
+	XCTAssertEqual(view.size(), 4u);
+	XCTAssertEqual(view[view.IndexOf('freq')].defaultValue, 1000.f);
+	XCTAssertFalse(view.Contains('none'));
+	XCTAssertFalse(AUParameterTableView{}.Contains(0));
+
+	// sparse IDs, built at runtime
+	constexpr size_t kCount = 200;
+	std::array<AUParameterDescriptor, kCount> descriptors{};
+	for (size_t i = 0; i < kCount; ++i) {
+		descriptors[i].id = static_cast<AudioUnitParameterID>(i * 7919u + 'a');
+	}
+	const ausdk::AUParameterTable<kCount> table{ descriptors };
+	for (size_t i = 0; i < kCount; ++i) {
+		XCTAssertEqual(table.IndexOf(descriptors[i].id), i);
+	}
+	XCTAssertEqual(table.IndexOf(1), AUParameterTableView::npos);
+
+	descriptors[1].id = descriptors[0].id;
+	XCTAssertThrows(ausdk::AUParameterTable<kCount>{ descriptors });
+}
+
 - (void)testAUBufferList
 {
 	//	constexpr unsigned kLargeBufSize = 512;
@@ -156,4 +262,1650 @@
 	XCTAssertEqual(ausdk::MakeStringFrom4CC('1234' + 0x7F), "123.");
 }
 
+- (void)testBinaryStateFormat
+{
+	using ausdk::AUBinaryState;
+
+	static_assert(AUBinaryState::Checksum({}) == 0);
+	const std::array<UInt8, 9> digits{ '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	XCTAssertEqual(AUBinaryState::Checksum(digits), 0xCBF43926u);
+	const auto head = std::span(digits).first(4);
+	const auto tail = std::span(digits).subspan(4);
+	XCTAssertEqual(AUBinaryState::Checksum(tail, AUBinaryState::Checksum(head)), 0xCBF43926u);
+
+	std::array<UInt8, 20> buffer{};
+	ausdk::AUBinaryStateWriter writer{ buffer };
+	writer.WriteUInt32(0x01020304);
+	writer.WriteFloat32(-1.5f);
+	writer.WriteBlock(std::span(digits).first(3));
+	writer.WriteAt(0, 7);
+	XCTAssertEqual(writer.Size(), 16u);
+	XCTAssertEqual(buffer[4 + 3], 0xBF); // little-endian
+	XCTAssertThrows(writer.WriteBytes(digits));
+
+	ausdk::AUBinaryStateReader reader{ writer.Written() };
+	XCTAssertEqual(reader.ReadUInt32(), 7u);
+	XCTAssertEqual(reader.ReadFloat32(), -1.5f);
+	const auto block = reader.ReadBlock();
+	XCTAssertTrue(std::ranges::equal(block, std::span(digits).first(3)));
+	XCTAssertTrue(reader.AtEnd());
+	XCTAssertThrows(reader.ReadUInt32());
+
+	// the big-endian words of embedded ClassInfo data
+	const std::array<UInt8, 6> bigEndian{ 0, 0, 1, 2, 3, 4 };
+	ausdk::AUBinaryStateReader bigEndianReader{ bigEndian };
+	XCTAssertEqual(bigEndianReader.ReadBigUInt32(), 0x0102u);
+	XCTAssertEqual(bigEndianReader.Unread().size(), 2u);
+	XCTAssertEqual(bigEndianReader.Unread()[0], 3);
+	XCTAssertThrows(bigEndianReader.ReadBigUInt32());
+}
+
+// An unregistered effect (so its component description is all zeros) with many parameters.
+static std::unique_ptr<ausdk::AUEffectBase> MakeStateTestEffect()
+{
+	constexpr UInt32 kParameterCount = 2000;
+	auto effect = std::make_unique<ausdk::AUEffectBase>(nullptr);
+	effect->DoPostConstructor();
+	for (UInt32 i = 0; i < kParameterCount; ++i) {
+		effect->Globals()->SetParameter(i * 3, static_cast<float>(i));
+	}
+	return effect;
+}
+
+- (void)testBinaryStateRoundTrip
+{
+	const auto source = MakeStateTestEffect();
+	const auto destination = MakeStateTestEffect();
+	destination->Globals()->SetParameter(30, -1.f);
+	source->GetScope(kAudioUnitScope_Output).GetElement(0)->SetName(CFSTR("Main Out"));
+
+	CFDataRef binaryState = nullptr;
+	XCTAssertEqual(source->SaveBinaryState(&binaryState), noErr);
+	XCTAssertEqual(destination->RestoreBinaryState(binaryState), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), 10.f);
+	XCTAssertTrue(CFEqual(
+		*destination->GetScope(kAudioUnitScope_Output).GetElement(0)->GetName(), CFSTR("Main Out")));
+
+	// the restored unit's ClassInfo matches the original's
+	CFPropertyListRef sourceClassInfo = nullptr;
+	CFPropertyListRef destinationClassInfo = nullptr;
+	XCTAssertEqual(source->SaveState(&sourceClassInfo), noErr);
+	XCTAssertEqual(destination->SaveState(&destinationClassInfo), noErr);
+	XCTAssertTrue(CFEqual(sourceClassInfo, destinationClassInfo));
+	CFRelease(sourceClassInfo);
+	CFRelease(destinationClassInfo);
+
+	// corrupted data is rejected
+	const auto corrupted = ausdk::Owned<CFMutableDataRef>::from_create(
+		CFDataCreateMutableCopy(nullptr, 0, binaryState));
+	CFDataGetMutableBytePtr(*corrupted)[CFDataGetLength(*corrupted) - 1] ^= 1;
+	XCTAssertEqual(destination->RestoreBinaryState(*corrupted), kAudioUnitErr_InvalidPropertyValue);
+	XCTAssertEqual(destination->RestoreBinaryState(nullptr), kAudioUnitErr_InvalidPropertyValue);
+	CFRelease(binaryState);
+}
+
+- (void)testDeltaState
+{
+	const auto source = MakeStateTestEffect();
+	const auto destination = MakeStateTestEffect();
+	destination->Globals()->SetParameter(30, -1.f);
+
+	CFDataRef full = nullptr;
+	CFDataRef first = nullptr;
+	CFDataRef second = nullptr;
+	XCTAssertEqual(source->SaveBinaryState(&full), noErr);
+	XCTAssertEqual(source->SaveDeltaState(&first), noErr); // no defaults known: everything
+	source->Globals()->SetParameter(3, 100.f);
+	source->Globals()->SetParameter(3000, 200.f);
+	XCTAssertEqual(source->SaveDeltaState(&second), noErr);
+	XCTAssertGreaterThan(CFDataGetLength(first), CFDataGetLength(full));
+	XCTAssertLessThan(CFDataGetLength(second), 100);
+
+	// deltas apply in order only
+	XCTAssertEqual(destination->RestoreBinaryState(second), kAudioUnitErr_InvalidPropertyValue);
+	XCTAssertEqual(destination->RestoreBinaryState(first), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), 10.f);
+	destination->Globals()->SetParameter(30, -1.f); // reverted to the base by the next delta
+	XCTAssertEqual(destination->RestoreBinaryState(second), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(3), 100.f);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), 10.f);
+
+	CFPropertyListRef sourceClassInfo = nullptr;
+	CFPropertyListRef destinationClassInfo = nullptr;
+	XCTAssertEqual(source->SaveState(&sourceClassInfo), noErr);
+	XCTAssertEqual(destination->SaveState(&destinationClassInfo), noErr);
+	XCTAssertTrue(CFEqual(sourceClassInfo, destinationClassInfo));
+	CFRelease(sourceClassInfo);
+	CFRelease(destinationClassInfo);
+
+	// the chain continues from the restored delta
+	CFDataRef third = nullptr;
+	XCTAssertEqual(destination->SaveDeltaState(&third), noErr);
+	XCTAssertEqual(source->RestoreBinaryState(third), noErr);
+	CFRelease(full);
+	CFRelease(first);
+	CFRelease(second);
+	CFRelease(third);
+}
+
+- (void)testPresetBank
+{
+	const auto source = MakeStateTestEffect();
+	const auto destination = MakeStateTestEffect();
+
+	CFDataRef initState = nullptr;
+	CFDataRef brightState = nullptr;
+	XCTAssertEqual(source->SaveBinaryState(&initState), noErr);
+	source->Globals()->SetParameter(30, 42.f);
+	XCTAssertEqual(source->SaveBinaryState(&brightState), noErr);
+
+	const std::array<ausdk::AUPresetBank::Preset, 2> presets{ {
+		{ .number = 1, .name = CFSTR("Bright"), .state = brightState },
+		{ .number = 0, .name = CFSTR("Init"), .state = initState },
+	} };
+	const auto encoded = ausdk::AUPresetBank::Encode(presets);
+	CFRelease(initState);
+	CFRelease(brightState);
+	auto bank = std::make_shared<const ausdk::AUPresetBank>(std::span(encoded));
+	XCTAssertEqual(bank->Count(), 2u);
+	XCTAssertEqual(bank->Find(1), std::optional<size_t>{ 1 });
+	XCTAssertFalse(bank->Find(7).has_value());
+	XCTAssertThrows(ausdk::AUPresetBank(std::span(encoded).first(8)));
+
+	XCTAssertEqual(destination->GetPresets(nullptr), kAudioUnitErr_InvalidProperty);
+	destination->SetFactoryPresetBank(bank);
+	CFArrayRef array = nullptr;
+	XCTAssertEqual(destination->GetPresets(&array), noErr);
+	XCTAssertEqual(CFArrayGetCount(array), 2);
+	const auto* bright = static_cast<const AUPreset*>(CFArrayGetValueAtIndex(array, 1));
+	XCTAssertEqual(bright->presetNumber, 1);
+	XCTAssertTrue(CFEqual(bright->presetName, CFSTR("Bright")));
+	CFRelease(array);
+
+	destination->Globals()->SetParameter(30, -1.f);
+	XCTAssertEqual(destination->NewFactoryPresetSet({ 1, nullptr }), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), 42.f);
+	XCTAssertEqual(destination->NewFactoryPresetSet({ 0, nullptr }), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), 10.f);
+	XCTAssertEqual(
+		destination->NewFactoryPresetSet({ 7, nullptr }), kAudioUnitErr_InvalidPropertyValue);
+
+	// the index records the state's own length, not its padded one
+	const std::array<UInt8, 5> oddBytes{ 1, 2, 3, 4, 5 };
+	const auto oddState = ausdk::Owned<CFDataRef>::from_create(
+		CFDataCreate(nullptr, oddBytes.data(), static_cast<CFIndex>(oddBytes.size())));
+	const std::array<ausdk::AUPresetBank::Preset, 1> oddPresets{ {
+		{ .number = 0, .name = CFSTR("Odd"), .state = *oddState },
+	} };
+	const auto oddEncoded = ausdk::AUPresetBank::Encode(oddPresets);
+	const ausdk::AUPresetBank oddBank{ std::span(oddEncoded) };
+	const auto restored = oddBank.StateAt(0);
+	XCTAssertEqual(CFDataGetLength(*restored), static_cast<CFIndex>(oddBytes.size()));
+	XCTAssertTrue(std::equal(oddBytes.begin(), oddBytes.end(), CFDataGetBytePtr(*restored)));
+}
+
+- (void)testDeferredParameterRestore
+{
+	const auto source = MakeStateTestEffect();
+	const auto destination = MakeStateTestEffect();
+	source->Globals()->SetParameter(30, -1.f);
+	CFPropertyListRef state = nullptr;
+	XCTAssertEqual(source->SaveState(&state), noErr);
+
+	destination->SetDefersParameterRestore(true);
+	XCTAssertEqual(destination->DoInitialize(), noErr);
+	XCTAssertEqual(destination->RestoreState(state), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), 10.f); // not rendered yet
+
+	constexpr UInt32 kFrames = 64;
+	ausdk::AUBufferList buffers;
+	const auto& format = destination->Input(0).GetStreamFormat();
+	buffers.Allocate(format, kFrames);
+	auto& bufferList = buffers.PrepareBuffer(format, kFrames);
+	AudioUnitRenderActionFlags flags = 0;
+	const AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+	XCTAssertEqual(destination->DoProcess(flags, timeStamp, kFrames, bufferList), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), -1.f);
+
+	// pending parameters are applied on cleanup
+	destination->Globals()->SetParameter(30, 0.f);
+	XCTAssertEqual(destination->RestoreState(state), noErr);
+	XCTAssertEqual(destination->Globals()->GetParameter(30), 0.f);
+	destination->DoCleanup();
+	XCTAssertEqual(destination->Globals()->GetParameter(30), -1.f);
+	CFRelease(state);
+}
+
+- (void)testDeferredParameterRestoreIgnoresUndefinedIDs
+{
+	const auto source = MakeStateTestEffect();
+	source->Globals()->SetParameter(30, -1.f);
+	CFPropertyListRef state = nullptr;
+	XCTAssertEqual(source->SaveState(&state), noErr);
+
+	// An indexed element cannot define the source's other IDs; they are dropped when restoring.
+	ausdk::AUEffectBase destination{ nullptr };
+	destination.DoPostConstructor();
+	destination.Globals()->UseIndexedParameters(40);
+	destination.SetDefersParameterRestore(true);
+	XCTAssertEqual(destination.DoInitialize(), noErr);
+	XCTAssertEqual(destination.RestoreState(state), noErr);
+
+	constexpr UInt32 kFrames = 64;
+	ausdk::AUBufferList buffers;
+	const auto& format = destination.Input(0).GetStreamFormat();
+	buffers.Allocate(format, kFrames);
+	auto& bufferList = buffers.PrepareBuffer(format, kFrames);
+	AudioUnitRenderActionFlags flags = 0;
+	const AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+	XCTAssertEqual(destination.DoProcess(flags, timeStamp, kFrames, bufferList), noErr);
+	XCTAssertEqual(destination.Globals()->GetParameter(30), -1.f);
+	XCTAssertEqual(destination.Globals()->GetParameter(3), 1.f);
+	destination.DoCleanup();
+	CFRelease(state);
+}
+
+// Records the value of global parameter 0 for each slice of ProcessForScheduledParams.
+class MorphTestEffect : public ausdk::AUEffectBase {
+public:
+	MorphTestEffect() : AUEffectBase(nullptr) {}
+
+	using AUBase::ParameterEventList;
+	using AUBase::ProcessForScheduledParams;
+
+	OSStatus ProcessScheduledSlice(void* /*inUserData*/, UInt32 inStartFrameInBuffer,
+		UInt32 /*inSliceFramesToProcess*/, UInt32 /*inTotalBufferFrames*/) override
+	{
+		mSlices.emplace_back(inStartFrameInBuffer, Globals()->GetParameter(0));
+		return noErr;
+	}
+
+	std::vector<std::pair<UInt32, AudioUnitParameterValue>> mSlices;
+};
+
+- (void)testParameterMorph
+{
+	MorphTestEffect effect;
+	effect.DoPostConstructor();
+	for (AudioUnitParameterID paramID = 0; paramID < 3; ++paramID) {
+		effect.Globals()->SetParameter(paramID, 0.f);
+	}
+	XCTAssertEqual(effect.DoInitialize(), noErr);
+
+	const auto makeTarget = [&] {
+		auto target = std::make_unique<ausdk::AUParameterSnapshot>();
+		const std::array<ausdk::AUParameterIDValue, 2> values{ { { 0, 100.f }, { 1, 200.f } } };
+		target->Add(*effect.Globals(), values);
+		return target;
+	};
+	XCTAssertThrows(effect.BeginParameterMorph(makeTarget(), 0)); // no position parameter
+
+	// timed: over 100 frames, ending exactly at frame 100
+	effect.BeginParameterMorph(makeTarget(), 100);
+	MorphTestEffect::ParameterEventList events;
+	XCTAssertEqual(effect.ProcessForScheduledParams(events, 64, nullptr), noErr);
+	XCTAssertTrue(effect.IsMorphingParameters());
+	XCTAssertEqual(effect.ProcessForScheduledParams(events, 64, nullptr), noErr);
+	XCTAssertFalse(effect.IsMorphingParameters());
+	using Slice = std::pair<UInt32, AudioUnitParameterValue>;
+	XCTAssertTrue((effect.mSlices == std::vector<Slice>{ { 0, 0.f }, { 0, 64.f }, { 36, 100.f } }));
+	XCTAssertEqual(effect.Globals()->GetParameter(1), 200.f);
+	XCTAssertEqual(effect.Globals()->GetParameter(2), 0.f);
+
+	// positioned by an automated parameter
+	effect.Globals()->SetParameter(0, 0.f);
+	effect.SetParameterMorphPosition(2);
+	effect.BeginParameterMorph(makeTarget(), 0);
+	effect.mSlices.clear();
+	AudioUnitParameterEvent ramp{ .scope = kAudioUnitScope_Global,
+		.element = 0,
+		.parameter = 2,
+		.eventType = kParameterEvent_Ramped };
+	ramp.eventValues.ramp = { .startBufferOffset = 0,
+		.durationInFrames = 128,
+		.startValue = 0.f,
+		.endValue = 1.f };
+	AudioUnitParameterEvent split{ .scope = kAudioUnitScope_Global,
+		.element = 0,
+		.parameter = 1,
+		.eventType = kParameterEvent_Immediate };
+	split.eventValues.immediate = { .bufferOffset = 32, .value = 0.f };
+	events = { ramp, split };
+	XCTAssertEqual(effect.ProcessForScheduledParams(events, 64, nullptr), noErr);
+	XCTAssertTrue((effect.mSlices == std::vector<Slice>{ { 0, 0.f }, { 32, 25.f } }));
+	XCTAssertTrue(effect.IsMorphingParameters());
+}
+
+// Adds a 4CC property to AUEffectBase's and replaces its InPlaceProcessing handler.
+class RegistryTestEffect : public ausdk::AUEffectBase {
+public:
+	static constexpr AudioUnitPropertyID kCounterProperty = 'ctr ';
+
+	RegistryTestEffect() : AUEffectBase{ nullptr } {}
+
+	[[nodiscard]] const ausdk::AUPropertyRegistry& GetPropertyRegistry() const override
+	{
+		static const ausdk::AUPropertyRegistry registry{ AUEffectBase::GetPropertyRegistry(),
+			std::array{
+				ausdk::AUPropertyRegistry::Handler{ .id = kCounterProperty,
+					.scopes = ausdk::AUPropertyRegistry::kAnyScope,
+					.dataSize = sizeof(UInt32),
+					.get = [](ausdk::AUBase& unit, AudioUnitPropertyID, AudioUnitScope,
+							   AudioUnitElement, void* outData) -> OSStatus {
+						auto& effect = static_cast<RegistryTestEffect&>(unit);
+						ausdk::Serialize(++effect.mCounter, outData);
+						return noErr;
+					} },
+				ausdk::AUPropertyRegistry::Handler{
+					.id = kAudioUnitProperty_InPlaceProcessing, .dataSize = sizeof(UInt32) } } };
+		return registry;
+	}
+
+	UInt32 mCounter{ 0 };
+};
+
+- (void)testPropertyRegistry
+{
+	RegistryTestEffect effect;
+	effect.DoPostConstructor();
+	const auto& registry = effect.GetPropertyRegistry();
+	XCTAssertEqual(registry.Handlers().size(), 3u);
+	XCTAssertTrue(std::ranges::is_sorted(
+		registry.Handlers(), {}, &ausdk::AUPropertyRegistry::Handler::id));
+	XCTAssertNotEqual(registry.Find(kAudioUnitProperty_BypassEffect), nullptr);
+	XCTAssertEqual(registry.Find(kAudioUnitProperty_Latency), nullptr); // dispatched by AUBase
+
+	UInt32 size = 0;
+	bool writable = false;
+	XCTAssertEqual(effect.DispatchGetPropertyInfo(
+					   kAudioUnitProperty_BypassEffect, kAudioUnitScope_Global, 0, size, writable),
+		noErr);
+	XCTAssertEqual(size, sizeof(UInt32));
+	XCTAssertTrue(writable);
+	XCTAssertEqual(effect.DispatchGetPropertyInfo(
+					   kAudioUnitProperty_BypassEffect, kAudioUnitScope_Input, 0, size, writable),
+		kAudioUnitErr_InvalidScope);
+
+	const UInt32 bypass = 1;
+	XCTAssertEqual(effect.DispatchSetProperty(kAudioUnitProperty_BypassEffect,
+					   kAudioUnitScope_Global, 0, &bypass, sizeof(bypass)),
+		noErr);
+	XCTAssertTrue(effect.IsBypassEffect());
+	XCTAssertEqual(effect.DispatchSetProperty(kAudioUnitProperty_BypassEffect,
+					   kAudioUnitScope_Global, 0, &bypass, sizeof(UInt16)),
+		kAudioUnitErr_InvalidPropertyValue);
+
+	// the subclass's handlers
+	UInt32 value = 0;
+	XCTAssertEqual(effect.DispatchGetProperty(
+					   RegistryTestEffect::kCounterProperty, kAudioUnitScope_Output, 0, &value),
+		noErr);
+	XCTAssertEqual(value, 1u);
+	XCTAssertEqual(effect.DispatchSetProperty(kAudioUnitProperty_InPlaceProcessing,
+					   kAudioUnitScope_Global, 0, &bypass, sizeof(bypass)),
+		kAudioUnitErr_PropertyNotWritable);
+	XCTAssertEqual(effect.DispatchGetProperty('none', kAudioUnitScope_Global, 0, &value),
+		kAudioUnitErr_InvalidProperty);
+}
+
+// Publishes a "spectrum" from its render thread through a custom property.
+class SnapshotTestEffect : public ausdk::AUEffectBase {
+public:
+	static constexpr AudioUnitPropertyID kSpectrumProperty = 'spec';
+	using Spectrum = std::array<float, 512>;
+
+	SnapshotTestEffect() : AUEffectBase{ nullptr } {}
+
+	[[nodiscard]] const ausdk::AUPropertyRegistry& GetPropertyRegistry() const override
+	{
+		static const ausdk::AUPropertyRegistry registry{ AUEffectBase::GetPropertyRegistry(),
+			std::array{ MakeSnapshotPropertyHandler<&SnapshotTestEffect::mSpectrum>(
+				kSpectrumProperty) } };
+		return registry;
+	}
+
+	ausdk::AUTripleBuffer<Spectrum> mSpectrum;
+};
+
+- (void)testSnapshotProperty
+{
+	static_assert(alignof(SnapshotTestEffect) <= 16); // as units are constructed
+	SnapshotTestEffect effect;
+	effect.DoPostConstructor();
+	UInt32 size = 0;
+	bool writable = true;
+	XCTAssertEqual(effect.DispatchGetPropertyInfo(SnapshotTestEffect::kSpectrumProperty,
+					   kAudioUnitScope_Global, 0, size, writable),
+		noErr);
+	XCTAssertEqual(size, sizeof(SnapshotTestEffect::Spectrum));
+	XCTAssertFalse(writable);
+
+	// only the newest snapshot is read
+	for (int i = 1; i <= 3; ++i) {
+		effect.mSpectrum.WriteBuffer().fill(static_cast<float>(i));
+		effect.mSpectrum.Publish();
+	}
+	SnapshotTestEffect::Spectrum spectrum{};
+	XCTAssertEqual(effect.DispatchGetProperty(
+					   SnapshotTestEffect::kSpectrumProperty, kAudioUnitScope_Global, 0, &spectrum),
+		noErr);
+	XCTAssertTrue(std::ranges::all_of(spectrum, [](float bin) { return bin == 3.f; }));
+	XCTAssertFalse(effect.mSpectrum.Read(spectrum));
+
+	// a writer thread never tears a snapshot
+	std::atomic<bool> done{ false };
+	std::thread writer([&] {
+		for (int i = 0; i < 10000; ++i) {
+			effect.mSpectrum.WriteBuffer().fill(static_cast<float>(i));
+			effect.mSpectrum.Publish();
+		}
+		done = true;
+	});
+	bool consistent = true;
+	while (!done) {
+		effect.mSpectrum.Read([&](const SnapshotTestEffect::Spectrum& snapshot) {
+			consistent = consistent && std::ranges::count(snapshot, snapshot[0]) == 512;
+		});
+	}
+	writer.join();
+	XCTAssertTrue(consistent);
+}
+
+- (void)testMetering
+{
+	const auto effect = MakeStateTestEffect();
+	auto& output = effect->Output(0);
+	UInt32 size = 0;
+	bool writable = true;
+	XCTAssertEqual(effect->DispatchGetPropertyInfo(
+					   ausdk::kAUSDKProperty_Meters, kAudioUnitScope_Output, 0, size, writable),
+		kAudioUnitErr_PropertyNotInUse);
+
+	output.SetMeteringEnabled(true);
+	XCTAssertEqual(effect->DispatchGetPropertyInfo(
+					   ausdk::kAUSDKProperty_Meters, kAudioUnitScope_Output, 0, size, writable),
+		noErr);
+	XCTAssertEqual(size, 2 * sizeof(ausdk::AUChannelMeterValues));
+	XCTAssertFalse(writable);
+
+	// an odd frame count exercises the scalar tail
+	constexpr UInt32 kFrames = 101;
+	ausdk::AUBufferList buffers;
+	const auto& format = output.GetStreamFormat();
+	buffers.Allocate(format, kFrames);
+	auto& bufferList = buffers.PrepareBuffer(format, kFrames);
+	const auto left = static_cast<Float32*>(bufferList.mBuffers[0].mData);  // NOLINT
+	const auto right = static_cast<Float32*>(bufferList.mBuffers[1].mData);  // NOLINT
+	for (UInt32 frame = 0; frame < kFrames; ++frame) {
+		left[frame] = -0.5f;                          // NOLINT
+		right[frame] = (frame % 2 == 0) ? 2.f : -2.f; // NOLINT
+	}
+	left[kFrames - 1] = 0.75f; // NOLINT
+	output.Meter(bufferList, kFrames);
+
+	std::array<ausdk::AUChannelMeterValues, 2> meters{};
+	XCTAssertEqual(effect->DispatchGetProperty(
+					   ausdk::kAUSDKProperty_Meters, kAudioUnitScope_Output, 0, meters.data()),
+		noErr);
+	XCTAssertEqual(meters[0].mPeak, 0.75f);
+	XCTAssertEqualWithAccuracy(meters[0].mRMS, 0.5f, 0.01f);
+	XCTAssertEqual(meters[0].mClipCount, 0u);
+	XCTAssertEqual(meters[1].mPeak, 2.f);
+	XCTAssertEqualWithAccuracy(meters[1].mRMS, 2.f, 0.001f);
+	XCTAssertEqual(meters[1].mClipCount, kFrames);
+
+	// peaks are reset by each read; clip counts accumulate
+	output.Meter(bufferList, kFrames);
+	XCTAssertEqual(effect->DispatchGetProperty(
+					   ausdk::kAUSDKProperty_Meters, kAudioUnitScope_Output, 0, meters.data()),
+		noErr);
+	XCTAssertEqual(meters[1].mClipCount, 2 * kFrames);
+	XCTAssertEqual(effect->DispatchGetProperty(
+					   ausdk::kAUSDKProperty_Meters, kAudioUnitScope_Output, 0, meters.data()),
+		noErr);
+	XCTAssertEqual(meters[0].mPeak, 0.f);
+	XCTAssertEqual(meters[1].mPeak, 0.f);
+
+	output.SetMeteringEnabled(false);
+	XCTAssertEqual(effect->DispatchGetProperty(
+					   ausdk::kAUSDKProperty_Meters, kAudioUnitScope_Output, 0, meters.data()),
+		kAudioUnitErr_PropertyNotInUse);
+}
+
+// Counts the calls to its kernels, which pass audio through and have a 256-frame tail.
+class TailTestEffect : public ausdk::AUEffectBase {
+public:
+	class Kernel : public ausdk::AUKernelBase {
+	public:
+		using AUKernelBase::AUKernelBase;
+
+		void Resume() override { ++mResumeCount; }
+		void Process(const Float32* inSourceP, Float32* inDestP, UInt32 inFramesToProcess,
+			bool& /*ioSilence*/) override
+		{
+			std::memmove(inDestP, inSourceP, inFramesToProcess * sizeof(Float32));
+			++mProcessCount;
+		}
+
+		int mProcessCount = 0;
+		int mResumeCount = 0;
+	};
+
+	TailTestEffect() : AUEffectBase{ nullptr } {}
+
+	std::unique_ptr<ausdk::AUKernelBase> NewKernel() override
+	{
+		return std::make_unique<Kernel>(*this);
+	}
+	Float64 GetTailTime() override { return 256. / GetSampleRate(); } // NOLINT
+
+	[[nodiscard]] Kernel& GetTestKernel(UInt32 index) const
+	{
+		return static_cast<Kernel&>(*GetKernel(index));
+	}
+};
+
+- (void)testSkipSilentKernels
+{
+	TailTestEffect effect;
+	effect.DoPostConstructor();
+	effect.SetSkipsSilentKernels(true);
+	XCTAssertEqual(effect.DoInitialize(), noErr);
+
+	constexpr UInt32 kFrames = 128;
+	ausdk::AUBufferList buffers;
+	const auto& format = effect.Input(0).GetStreamFormat();
+	buffers.Allocate(format, kFrames);
+	auto& bufferList = buffers.PrepareBuffer(format, kFrames);
+	AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+	const auto render = [&](bool silent) {
+		AudioUnitRenderActionFlags flags = silent ? kAudioUnitRenderAction_OutputIsSilence : 0;
+		XCTAssertEqual(effect.DoProcess(flags, timeStamp, kFrames, bufferList), noErr);
+		timeStamp.mSampleTime += kFrames;
+		return (flags & kAudioUnitRenderAction_OutputIsSilence) != 0;
+	};
+	auto& kernel = effect.GetTestKernel(1);
+
+	XCTAssertFalse(render(false));
+	// the kernels keep running through the tail, and once more after it
+	XCTAssertFalse(render(true));
+	XCTAssertFalse(render(true));
+	XCTAssertTrue(render(true));
+	XCTAssertTrue(kernel.IsIdle());
+	XCTAssertEqual(kernel.mProcessCount, 4);
+
+	XCTAssertTrue(render(true));
+	XCTAssertTrue(render(true));
+	XCTAssertEqual(kernel.mProcessCount, 4);
+	XCTAssertEqual(kernel.mResumeCount, 0);
+
+	XCTAssertFalse(render(false));
+	XCTAssertFalse(kernel.IsIdle());
+	XCTAssertEqual(kernel.mProcessCount, 5);
+	XCTAssertEqual(kernel.mResumeCount, 1);
+
+	// disabling the skipping resumes an idle kernel even while the input stays silent
+	render(true);
+	render(true);
+	render(true);
+	XCTAssertTrue(kernel.IsIdle());
+	effect.SetSkipsSilentKernels(false);
+	render(true);
+	XCTAssertFalse(kernel.IsIdle());
+	XCTAssertEqual(kernel.mResumeCount, 2);
+}
+
+// Renders kFrames of silence, pointing the input at the shared zeros when refCon is non-null.
+static OSStatus RenderSilentInput(void* inRefCon, AudioUnitRenderActionFlags* ioActionFlags,
+	const AudioTimeStamp* /*inTimeStamp*/, UInt32 /*inBusNumber*/, UInt32 /*inNumberFrames*/,
+	AudioBufferList* ioData)
+{
+	*ioActionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+	if (inRefCon != nullptr) {
+		for (UInt32 i = 0; i < ioData->mNumberBuffers; ++i) {
+			ioData->mBuffers[i].mData = // NOLINT
+				const_cast<void*>(ausdk::AUZeroBufferPool::Get(ioData->mBuffers[i].mDataByteSize));
+		}
+	} else {
+		ausdk::AUBufferList::ZeroBuffer(*ioData);
+	}
+	return noErr;
+}
+
+// Records the value of global parameter 0 for each render cycle, without slicing the buffer.
+class UnslicedMorphEffect : public ausdk::AUEffectBase {
+public:
+	UnslicedMorphEffect() : AUEffectBase(nullptr) {}
+
+	OSStatus ProcessBufferLists(AudioUnitRenderActionFlags& /*ioActionFlags*/,
+		const AudioBufferList& /*inBuffer*/, AudioBufferList& /*outBuffer*/,
+		UInt32 /*inFramesToProcess*/) override
+	{
+		mValues.push_back(Globals()->GetParameter(0));
+		return noErr;
+	}
+
+	std::vector<AudioUnitParameterValue> mValues;
+};
+
+- (void)testUnslicedParameterMorph
+{
+	constexpr UInt32 kFrames = 64;
+	// renders three cycles, through DoRender and AUEffectBase's slicing Render, or through
+	// DoProcess, which calls ProcessBufferLists directly
+	const auto render = [](ausdk::AUEffectBase& effect, bool process) {
+		ausdk::AUBufferList buffers;
+		const auto& format = effect.Output(0).GetStreamFormat();
+		buffers.Allocate(format, kFrames);
+		AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+		for (int cycle = 0; cycle < 3; ++cycle) {
+			AudioUnitRenderActionFlags flags = 0;
+			const OSStatus result =
+				process ? effect.DoProcess(
+							  flags, timeStamp, kFrames, buffers.PrepareBuffer(format, kFrames))
+						: effect.DoRender(flags, timeStamp, 0, kFrames,
+							  buffers.PrepareNullBuffer(format, kFrames));
+			if (result != noErr) {
+				return false;
+			}
+			timeStamp.mSampleTime += kFrames;
+		}
+		return true;
+	};
+	const auto prepare = [](ausdk::AUEffectBase& effect) {
+		effect.DoPostConstructor();
+		effect.Globals()->SetParameter(0, 0.f);
+		const AURenderCallbackStruct callback{ .inputProc = RenderSilentInput };
+		effect.DispatchSetProperty(kAudioUnitProperty_SetRenderCallback, kAudioUnitScope_Input,
+			0, &callback, sizeof(callback));
+		auto target = std::make_unique<ausdk::AUParameterSnapshot>();
+		const std::array<ausdk::AUParameterIDValue, 1> values{ { { 0, 100.f } } };
+		target->Add(*effect.Globals(), values);
+		const OSStatus result = effect.DoInitialize();
+		effect.BeginParameterMorph(std::move(target), 100);
+		return result;
+	};
+
+	// a unit which never calls ProcessForScheduledParams steps once per cycle
+	UnslicedMorphEffect unsliced;
+	XCTAssertEqual(prepare(unsliced), noErr);
+	XCTAssertTrue(render(unsliced, true));
+	XCTAssertFalse(unsliced.IsMorphingParameters());
+	XCTAssertTrue((unsliced.mValues == std::vector<AudioUnitParameterValue>{ 0.f, 64.f, 100.f }));
+
+	// a slicing unit is advanced only once in its first cycle, and sliced after that
+	MorphTestEffect sliced;
+	XCTAssertEqual(prepare(sliced), noErr);
+	XCTAssertTrue(render(sliced, false));
+	XCTAssertFalse(sliced.IsMorphingParameters());
+	using Slice = std::pair<UInt32, AudioUnitParameterValue>;
+	XCTAssertTrue((sliced.mSlices == std::vector<Slice>{ { 0, 0.f }, { 0, 64.f }, { 36, 100.f } }));
+}
+
+- (void)testSharedSilence
+{
+	constexpr UInt32 kFrames = 128;
+	ausdk::AUZeroBufferPool::Reserve(kFrames * sizeof(Float32));
+	const auto* const zeros =
+		static_cast<const std::byte*>(ausdk::AUZeroBufferPool::Get(kFrames * sizeof(Float32)));
+	XCTAssertNotEqual(zeros, nullptr);
+	XCTAssertTrue(ausdk::AUZeroBufferPool::Contains(zeros + kFrames - 1)); // NOLINT
+	const auto isZero = [](std::byte b) { return b == std::byte{}; };
+	XCTAssertTrue(std::all_of(zeros, zeros + kFrames, isZero)); // NOLINT pointer arithmetic
+	const AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+
+	// silent output into the unit's own buffers points at the shared zeros
+	{
+		TailTestEffect effect;
+		effect.DoPostConstructor();
+		effect.SetProcessesInPlace(false);
+		effect.SetSharesSilentBuffers(true);
+		const AURenderCallbackStruct callback{ .inputProc = RenderSilentInput };
+		XCTAssertEqual(effect.DispatchSetProperty(kAudioUnitProperty_SetRenderCallback,
+						   kAudioUnitScope_Input, 0, &callback, sizeof(callback)),
+			noErr);
+		XCTAssertEqual(effect.DoInitialize(), noErr);
+
+		ausdk::AUBufferList buffers;
+		const auto& format = effect.Output(0).GetStreamFormat();
+		buffers.Allocate(format, kFrames);
+		auto& bufferList = buffers.PrepareNullBuffer(format, kFrames);
+		AudioUnitRenderActionFlags flags = 0;
+		XCTAssertEqual(effect.DoRender(flags, timeStamp, 0, kFrames, bufferList), noErr);
+		XCTAssertNotEqual(flags & kAudioUnitRenderAction_OutputIsSilence, 0u);
+		XCTAssertTrue(ausdk::AUZeroBufferPool::Contains(bufferList));
+	}
+
+	// an in-place unit given the shared zeros as input processes out of place instead
+	{
+		TailTestEffect effect;
+		effect.DoPostConstructor();
+		static int sharedZeros = 0;
+		const AURenderCallbackStruct callback{ .inputProc = RenderSilentInput,
+			.inputProcRefCon = &sharedZeros };
+		XCTAssertEqual(effect.DispatchSetProperty(kAudioUnitProperty_SetRenderCallback,
+						   kAudioUnitScope_Input, 0, &callback, sizeof(callback)),
+			noErr);
+		XCTAssertEqual(effect.DoInitialize(), noErr);
+
+		ausdk::AUBufferList buffers;
+		const auto& format = effect.Output(0).GetStreamFormat();
+		buffers.Allocate(format, kFrames);
+		auto& bufferList = buffers.PrepareBuffer(format, kFrames);
+		const auto left = static_cast<Float32*>(bufferList.mBuffers[0].mData); // NOLINT
+		std::fill_n(left, kFrames, 1.f);
+		AudioUnitRenderActionFlags flags = 0;
+		XCTAssertEqual(effect.DoRender(flags, timeStamp, 0, kFrames, bufferList), noErr);
+		XCTAssertFalse(ausdk::AUZeroBufferPool::Contains(bufferList));
+		XCTAssertTrue(std::all_of(left, left + kFrames, [](Float32 x) { return x == 0.f; }));
+	}
+
+	// only units sharing silent buffers reserve zeros, and only for their maximum frames
+	{
+		constexpr UInt32 kLargeFrames = 1u << 20u;
+		TailTestEffect effect;
+		effect.DoPostConstructor();
+		effect.SetMaxFramesPerSlice(kLargeFrames);
+		XCTAssertEqual(effect.DoInitialize(), noErr);
+		const UInt32 largeBytes = kLargeFrames * sizeof(Float32);
+		XCTAssertEqual(ausdk::AUZeroBufferPool::Get(largeBytes), nullptr);
+
+		effect.SetSharesSilentBuffers(true);
+		XCTAssertNotEqual(ausdk::AUZeroBufferPool::Get(largeBytes), nullptr);
+	}
+}
+
+// Fills every input buffer with the Float32 that refCon points to.
+static OSStatus RenderConstantInput(void* inRefCon, AudioUnitRenderActionFlags* /*ioActionFlags*/,
+	const AudioTimeStamp* /*inTimeStamp*/, UInt32 /*inBusNumber*/, UInt32 inNumberFrames,
+	AudioBufferList* ioData)
+{
+	for (UInt32 i = 0; i < ioData->mNumberBuffers; ++i) {
+		std::fill_n(static_cast<Float32*>(ioData->mBuffers[i].mData), inNumberFrames, // NOLINT
+			*static_cast<const Float32*>(inRefCon));
+	}
+	return noErr;
+}
+
+- (void)testSilenceDetection
+{
+	auto effect = MakeStateTestEffect();
+	Float32 level = 1e-6f; // NOLINT magic number
+	const AURenderCallbackStruct callback{ .inputProc = RenderConstantInput,
+		.inputProcRefCon = &level };
+	XCTAssertEqual(effect->DispatchSetProperty(kAudioUnitProperty_SetRenderCallback,
+					   kAudioUnitScope_Input, 0, &callback, sizeof(callback)),
+		noErr);
+	XCTAssertEqual(effect->DoInitialize(), noErr);
+	auto& input = effect->Input(0);
+	const AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+	// an odd frame count exercises the scalar tail
+	constexpr UInt32 kFrames = 203;
+	const auto pull = [&] {
+		AudioUnitRenderActionFlags flags = 0;
+		XCTAssertEqual(input.PullInput(flags, timeStamp, 0, kFrames), noErr);
+		return (flags & kAudioUnitRenderAction_OutputIsSilence) != 0;
+	};
+
+	XCTAssertFalse(pull());
+	input.SetDetectsSilence(true);
+	XCTAssertFalse(pull());
+	input.SetDetectsSilence(true, 1e-5f); // NOLINT magic number
+	XCTAssertTrue(pull());
+	level = -1e-6f; // NOLINT magic number
+	XCTAssertTrue(pull());
+	level = 0.5f; // NOLINT magic number
+	XCTAssertFalse(pull());
+
+	// one loud sample, in the vectorized blocks or in the tail, is enough
+	level = 0.f;
+	XCTAssertTrue(pull());
+	auto& bufferList = input.GetBufferList();
+	const auto right = static_cast<Float32*>(bufferList.mBuffers[1].mData); // NOLINT
+	for (const UInt32 frame : { 0u, 100u, kFrames - 1 }) {
+		right[frame] = 0.5f; // NOLINT
+		XCTAssertFalse(input.IsBelowThreshold(bufferList, kFrames, 1e-5f));
+		// nor is a NaN silent
+		right[frame] = std::numeric_limits<Float32>::quiet_NaN(); // NOLINT
+		XCTAssertFalse(input.IsBelowThreshold(bufferList, kFrames, 1e-5f));
+		right[frame] = 0.f; // NOLINT
+	}
+	XCTAssertTrue(input.IsBelowThreshold(bufferList, kFrames, 1e-5f));
+}
+
+// Counts its calls in the int that refCon points to, and reports silence.
+static OSStatus CountSilentPulls(void* inRefCon, AudioUnitRenderActionFlags* ioActionFlags,
+	const AudioTimeStamp* /*inTimeStamp*/, UInt32 /*inBusNumber*/, UInt32 /*inNumberFrames*/,
+	AudioBufferList* /*ioData*/)
+{
+	++*static_cast<int*>(inRefCon);
+	*ioActionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+	return noErr;
+}
+
+- (void)testPullInputCache
+{
+	auto effect = MakeStateTestEffect();
+	int pullCount = 0;
+	const AURenderCallbackStruct callback{ .inputProc = CountSilentPulls,
+		.inputProcRefCon = &pullCount };
+	XCTAssertEqual(effect->DispatchSetProperty(kAudioUnitProperty_SetRenderCallback,
+					   kAudioUnitScope_Input, 0, &callback, sizeof(callback)),
+		noErr);
+	XCTAssertEqual(effect->DoInitialize(), noErr);
+	auto& input = effect->Input(0);
+	AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+	const auto pull = [&](UInt32 frames) {
+		AudioUnitRenderActionFlags flags = 0;
+		XCTAssertEqual(input.PullInput(flags, timeStamp, 0, frames), noErr);
+		XCTAssertNotEqual(flags & kAudioUnitRenderAction_OutputIsSilence, 0u);
+	};
+
+	pull(64);
+	pull(64);
+	XCTAssertEqual(pullCount, 2);
+
+	input.SetCachesPulls(true);
+	pull(64);
+	pull(64);
+	pull(64);
+	XCTAssertEqual(pullCount, 3);
+	pull(32); // a different frame count
+	timeStamp.mSampleTime = 32;
+	pull(32);
+	pull(32);
+	XCTAssertEqual(pullCount, 5);
+	XCTAssertEqual(input.GetPullCacheHits(), 3u);
+	XCTAssertEqual(input.GetPullCacheMisses(), 3u);
+
+	// a new callback invalidates the cache
+	XCTAssertEqual(effect->DispatchSetProperty(kAudioUnitProperty_SetRenderCallback,
+					   kAudioUnitScope_Input, 0, &callback, sizeof(callback)),
+		noErr);
+	pull(32);
+	XCTAssertEqual(pullCount, 6);
+}
+
+- (void)testPropertyChangeQueue
+{
+	const auto effect = MakeStateTestEffect();
+	std::vector<std::pair<AudioUnitPropertyID, AudioUnitElement>> notified;
+	const AudioUnitPropertyListenerProc listener = [](void* refCon, AudioUnit,
+													   AudioUnitPropertyID inID, AudioUnitScope,
+													   AudioUnitElement inElement) {
+		static_cast<decltype(notified)*>(refCon)->emplace_back(inID, inElement);
+	};
+	effect->AddPropertyListener(kAudioUnitProperty_Latency, listener, &notified);
+	effect->AddPropertyListener(kAudioUnitProperty_BypassEffect, listener, &notified);
+	effect->AddPropertyListener(kAudioUnitProperty_ElementName, listener, &notified);
+
+	effect->PropertyChanged(kAudioUnitProperty_Latency, kAudioUnitScope_Global, 0);
+	XCTAssertEqual(notified.size(), 1u);
+
+	// deferred changes are coalesced
+	effect->SetDefersPropertyChanges(true);
+	for (int i = 0; i < 3; ++i) {
+		effect->PropertyChanged(kAudioUnitProperty_ElementName, kAudioUnitScope_Input, 0);
+		effect->PropertyChanged(kAudioUnitProperty_ElementName, kAudioUnitScope_Input, 1);
+	}
+	effect->PropertyChanged(kAudioUnitProperty_SampleRate, kAudioUnitScope_Global, 0);
+	XCTAssertEqual(notified.size(), 1u);
+	XCTAssertEqual(effect->DispatchPropertyChanges(), 3u);
+	XCTAssertEqual(notified.size(), 3u);
+	const std::pair<AudioUnitPropertyID, AudioUnitElement> secondInput{
+		kAudioUnitProperty_ElementName, 1
+	};
+	XCTAssertEqual(std::ranges::count(notified, secondInput), 1);
+	XCTAssertEqual(effect->DispatchPropertyChanges(), 0u);
+
+	// on a dispatcher thread
+	effect->StartPropertyChangeDispatcher(std::chrono::milliseconds{ 1 });
+	effect->PropertyChanged(kAudioUnitProperty_BypassEffect, kAudioUnitScope_Global, 0);
+	effect->StopPropertyChangeDispatcher();
+	XCTAssertEqual(notified.size(), 4u);
+	XCTAssertFalse(effect->DefersPropertyChanges());
+
+	// a removed listener is no longer called
+	effect->RemovePropertyListener(kAudioUnitProperty_Latency, listener, &notified, true);
+	effect->PropertyChanged(kAudioUnitProperty_Latency, kAudioUnitScope_Global, 0);
+	effect->PropertyChanged(kAudioUnitProperty_BypassEffect, kAudioUnitScope_Global, 0);
+	XCTAssertEqual(notified.size(), 5u);
+	XCTAssertEqual(notified.back().first, kAudioUnitProperty_BypassEffect);
+
+	// slots of delivered changes are reused, so distinct changes beyond the capacity fit
+	ausdk::AUPropertyChangeQueue queue;
+	size_t delivered = 0;
+	const auto countDelivery = [&](const ausdk::AUPropertyChangeQueue::Change&) { ++delivered; };
+	for (AudioUnitElement element = 0; element < 4 * ausdk::AUPropertyChangeQueue::kCapacity;
+		++element) {
+		XCTAssertTrue(queue.Post({ .propertyID = kAudioUnitProperty_ElementName,
+			.scope = kAudioUnitScope_Input,
+			.element = element }));
+		if ((element + 1) % (ausdk::AUPropertyChangeQueue::kCapacity / 2) == 0) {
+			queue.Drain(countDelivery);
+			XCTAssertEqual(queue.Drain(countDelivery), 0u); // frees the slots
+		}
+	}
+	XCTAssertEqual(delivered, 4 * ausdk::AUPropertyChangeQueue::kCapacity);
+	XCTAssertEqual(queue.DroppedCount(), 0u);
+}
+
+- (void)testEpochReclamation
+{
+	// units are constructed in storage which is only 16-byte aligned
+	static_assert(alignof(ausdk::AUBase) <= 16);
+
+	static int liveCount = 0;
+	struct Resource {
+		explicit Resource(int v) : value{ v } { ++liveCount; }
+		~Resource() { --liveCount; }
+		int value;
+	};
+	{
+		ausdk::AUEpochDomain domain;
+		ausdk::AUEpochResource<Resource> resource{ domain, std::make_unique<Resource>(1) };
+
+		// a version replaced during a render cycle outlives the cycle
+		domain.EnterRender();
+		const Resource* const seen = resource.Get();
+		resource.Publish(std::make_unique<Resource>(2));
+		XCTAssertEqual(domain.Reclaim(), 0u);
+		XCTAssertEqual(seen->value, 1);
+		domain.ExitRender();
+		XCTAssertEqual(domain.Reclaim(), 1u);
+		XCTAssertEqual(liveCount, 1);
+
+		// a cycle which began after the replacement cannot see the old version
+		resource.Publish(std::make_unique<Resource>(3));
+		domain.EnterRender();
+		XCTAssertEqual(resource.Get()->value, 3);
+		XCTAssertEqual(domain.Reclaim(), 1u);
+		domain.ExitRender();
+
+		// on the reclaimer thread
+		domain.StartReclaimer(std::chrono::milliseconds{ 1 });
+		resource.Publish(std::make_unique<Resource>(4));
+		domain.StopReclaimer();
+		XCTAssertEqual(domain.RetiredCount(), 0u);
+
+		// left to the domain's destructor
+		resource.Publish(std::make_unique<Resource>(5));
+		XCTAssertEqual(liveCount, 2);
+	}
+	XCTAssertEqual(liveCount, 0);
+}
+
+- (void)testParameterChangeFeed
+{
+	const auto effect = MakeStateTestEffect();
+	std::vector<std::pair<AudioUnitParameterID, AudioUnitParameterValue>> changes;
+	const auto consume = [&] {
+		changes.clear();
+		effect->ConsumeParameterChangeFeed([&](AudioUnitScope scope, AudioUnitElement element,
+											   AudioUnitParameterID paramID,
+											   AudioUnitParameterValue value) {
+			XCTAssertEqual(scope, kAudioUnitScope_Global);
+			XCTAssertEqual(element, 0u);
+			changes.emplace_back(paramID, value);
+		});
+	};
+	consume();
+	XCTAssertEqual(changes.size(), 2000u);
+
+	// repeated changes are coalesced, with the latest value
+	for (int i = 0; i < 5; ++i) {
+		effect->Globals()->SetParameter(3, static_cast<float>(i));
+	}
+	effect->Globals()->SetParameter(6, -1.f);
+	consume();
+	const decltype(changes) expected{ { 3, 4.f }, { 6, -1.f } };
+	XCTAssertTrue(changes == expected);
+	consume();
+	XCTAssertTrue(changes.empty());
+
+	// independent of the kernels' change flags
+	size_t kernelChanges = 0;
+	effect->Globals()->ConsumeChangedParameters([&](AudioUnitParameterID) { ++kernelChanges; });
+	XCTAssertEqual(kernelChanges, 2000u);
+}
+
+// A unit with eight inputs, each fed by SynthesizeInput, for PullInputs.
+class ParallelPullTestUnit : public ausdk::AUBase {
+public:
+	static constexpr UInt32 kInputCount = 8;
+
+	ParallelPullTestUnit() : AUBase{ nullptr, kInputCount, 1 } {}
+
+	[[nodiscard]] bool CanScheduleParameters() const override { return false; }
+	bool StreamFormatWritable(AudioUnitScope /*scope*/, AudioUnitElement /*element*/) override
+	{
+		return true;
+	}
+};
+
+// A synthetic upstream: fills the input with a sine wave, at a few sine evaluations per sample.
+// Bus 5 fails when refCon is non-null; odd buses report silence.
+static OSStatus SynthesizeInput(void* inRefCon, AudioUnitRenderActionFlags* ioActionFlags,
+	const AudioTimeStamp* /*inTimeStamp*/, UInt32 inBusNumber, UInt32 inNumberFrames,
+	AudioBufferList* ioData)
+{
+	if (inRefCon != nullptr && inBusNumber == 5) { // NOLINT magic number
+		return kAudioUnitErr_NoConnection;
+	}
+	for (UInt32 i = 0; i < ioData->mNumberBuffers; ++i) {
+		auto* const samples = static_cast<Float32*>(ioData->mBuffers[i].mData); // NOLINT
+		for (UInt32 frame = 0; frame < inNumberFrames; ++frame) {
+			Float32 phase = static_cast<Float32>(frame) * 0.01f; // NOLINT magic number
+			for (int harmonic = 0; harmonic < 4; ++harmonic) {
+				phase = std::sin(phase + static_cast<Float32>(inBusNumber));
+			}
+			samples[frame] = (inBusNumber % 2 != 0) ? 0.f : phase; // NOLINT pointer arithmetic
+		}
+	}
+	if (inBusNumber % 2 != 0) {
+		*ioActionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+	}
+	return noErr;
+}
+
+static std::unique_ptr<ParallelPullTestUnit> MakeParallelPullTestUnit(void* refCon)
+{
+	auto unit = std::make_unique<ParallelPullTestUnit>();
+	unit->DoPostConstructor();
+	const AURenderCallbackStruct callback{ .inputProc = SynthesizeInput,
+		.inputProcRefCon = refCon };
+	for (UInt32 bus = 0; bus < ParallelPullTestUnit::kInputCount; ++bus) {
+		unit->DispatchSetProperty(kAudioUnitProperty_SetRenderCallback, kAudioUnitScope_Input, bus,
+			&callback, sizeof(callback));
+	}
+	unit->DoInitialize();
+	return unit;
+}
+
+- (void)testParallelPullInputs
+{
+	int failing = 0;
+	const auto unit = MakeParallelPullTestUnit(&failing);
+	const std::array<AudioUnitElement, 9> elements{ 0, 1, 2, 3, 4, 5, 6, 7, 99 };
+	const AudioTimeStamp timeStamp{ .mSampleTime = 0, .mFlags = kAudioTimeStampSampleTimeValid };
+	for (const UInt32 threadCount : { 0u, 3u, 0u }) {
+		unit->SetParallelPullThreadCount(threadCount);
+		XCTAssertEqual(unit->GetParallelPullThreadCount(), threadCount);
+		std::array<AudioUnitRenderActionFlags, elements.size()> flags{};
+		std::array<OSStatus, elements.size()> results{};
+		XCTAssertEqual(unit->PullInputs(elements, 0, timeStamp, 512, flags, results),
+			kAudioUnitErr_NoConnection);
+		for (size_t i = 0; i < 8; ++i) {
+			XCTAssertEqual(results[i], i == 5 ? kAudioUnitErr_NoConnection : noErr);
+			const bool silent = (flags[i] & kAudioUnitRenderAction_OutputIsSilence) != 0;
+			XCTAssertEqual(silent, i % 2 != 0 && i != 5);
+		}
+		XCTAssertEqual(results[8], kAudioUnitErr_InvalidElement);
+		const auto* const samples = unit->Input(2).GetFloat32ChannelData(1);
+		XCTAssertTrue(std::any_of(samples, samples + 512, [](Float32 x) { return x != 0.f; }));
+	}
+	XCTAssertEqual(unit->GetRenderEpochDomain().Reclaim(), 1u); // the retired workers
+}
+
+- (void)testWorkerPool
+{
+	ausdk::AUWorkerPool workers{ 3 };
+	XCTAssertEqual(workers.ThreadCount(), 3u);
+
+	// every task runs once per job, on the caller or on a worker
+	constexpr int kJobs = 100;
+	std::array<std::atomic<int>, 64> runs{};
+	auto run = [&](size_t index) noexcept { runs[index].fetch_add(1); };
+	for (int job = 0; job < kJobs; ++job) {
+		workers.Run(runs.size(), run);
+	}
+	XCTAssertTrue(std::ranges::all_of(runs, [](const auto& count) { return count == kJobs; }));
+
+	// A worker's task outlasts the caller's spin, so the caller sleeps until it finishes. The
+	// caller's own task waits for a worker to start the other one.
+	const auto caller = std::this_thread::get_id();
+	std::atomic<bool> workerStarted{ false };
+	std::atomic<bool> workerFinished{ false };
+	auto slow = [&](size_t /*index*/) noexcept {
+		if (std::this_thread::get_id() == caller) {
+			while (!workerStarted) {
+			}
+		} else {
+			workerStarted = true;
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+			workerFinished = true;
+		}
+	};
+	XCTAssertFalse(workers.Run(2, slow));
+	XCTAssertTrue(workerFinished);
+
+	// and the workers are woken for the next job as before
+	std::ranges::for_each(runs, [](auto& count) { count = 0; });
+	workers.Run(runs.size(), run);
+	XCTAssertTrue(std::ranges::all_of(runs, [](const auto& count) { return count == 1; }));
+}
+
+- (void)testParameterTableReplacesOtherStorage
+{
+	static constexpr ausdk::AUParameterTable kTable{ std::array{
+		ausdk::AUParameterDescriptor{ .id = 'gain', .maxValue = 1, .defaultValue = 0.5f },
+		ausdk::AUParameterDescriptor{ .id = 7, .maxValue = 10, .defaultValue = 2 } } };
+	const auto effect = MakeStateTestEffect();
+	auto& element = *effect->Globals();
+	XCTAssertTrue(element.HasParameterID(3));
+
+	element.UseParameterTable(kTable);
+	XCTAssertFalse(element.HasParameterID(3));
+	XCTAssertEqual(element.GetNumberOfParameters(), 2u);
+	XCTAssertEqual(element.GetParameter('gain'), 0.5f);
+	XCTAssertEqual(element.GetParameter(7), 2.f);
+
+	element.UseIndexedParameters(4);
+	XCTAssertFalse(element.HasParameterID('gain'));
+	XCTAssertTrue(element.HasParameterID(3));
+	element.SetParameter(3, 1.f);
+	XCTAssertEqual(element.GetParameter(3), 1.f);
+}
+
+- (void)testChangedParameterFlags
+{
+	const auto effect = MakeStateTestEffect();
+	auto& element = *effect->Globals();
+	std::vector<AudioUnitParameterID> changed;
+	const auto consume = [&] {
+		changed.clear();
+		element.ConsumeChangedParameters(
+			[&](AudioUnitParameterID paramID) { changed.push_back(paramID); });
+		std::ranges::sort(changed);
+	};
+
+	// defining the parameters raises every flag, and consuming clears them
+	consume();
+	XCTAssertEqual(changed.size(), 2000u);
+	consume();
+	XCTAssertTrue(changed.empty());
+
+	// each write path raises the flags of just the parameters it touches
+	element.SetParameter(3, 1.f);
+	consume();
+	XCTAssertTrue(changed == std::vector<AudioUnitParameterID>{ 3 });
+
+	const std::array<ausdk::AUParameterIDValue, 2> values{ { { 6, 1.f }, { 5997, 2.f } } };
+	element.SetParameters(values);
+	consume();
+	XCTAssertTrue((changed == std::vector<AudioUnitParameterID>{ 6, 5997 }));
+
+	const std::array indices{ element.IndexOfParameter(9), element.IndexOfParameter(12) };
+	const std::array<AudioUnitParameterValue, 2> indexedValues{ 3.f, 4.f };
+	element.SetParametersAtIndices(indices, indexedValues);
+	consume();
+	XCTAssertTrue((changed == std::vector<AudioUnitParameterID>{ 9, 12 }));
+
+	element.MarkParameterChanged(15);
+	consume();
+	XCTAssertTrue(changed == std::vector<AudioUnitParameterID>{ 15 });
+	XCTAssertThrows(element.MarkParameterChanged(1));
+
+	element.MarkAllParametersChanged();
+	consume();
+	XCTAssertEqual(changed.size(), 2000u);
+
+	// adding a parameter moves the map positions, so every flag is raised again, including
+	// those of the new parameter and of parameters in the last, partial word
+	element.SetParameter(1, 0.f);
+	consume();
+	XCTAssertEqual(changed.size(), 2001u);
+	XCTAssertEqual(changed.front(), 0u);
+	XCTAssertEqual(changed[1], 1u);
+	XCTAssertEqual(changed.back(), 5997u);
+
+	// shrinking to indexed parameters leaves no stale flags beyond the new count
+	element.UseIndexedParameters(3);
+	consume();
+	XCTAssertTrue((changed == std::vector<AudioUnitParameterID>{ 0, 1, 2 }));
+	element.SetParameter(2, 1.f);
+	consume();
+	XCTAssertTrue(changed == std::vector<AudioUnitParameterID>{ 2 });
+}
+
+- (void)testParameterTransactions
+{
+	const auto effect = MakeStateTestEffect();
+	auto& element = *effect->Globals();
+	constexpr size_t kCount = 64;
+	std::vector<ausdk::AUParameterIDValue> values(kCount);
+	for (size_t i = 0; i < kCount; ++i) {
+		values[i].mParameterID = static_cast<AudioUnitParameterID>(i * 3);
+	}
+	XCTAssertEqual(element.GetParameters(values), noErr);
+	XCTAssertEqual(values.back().mValue, 63.f);
+
+	// an unknown ID is reported rather than thrown
+	auto unknown = values;
+	unknown[10].mParameterID = 1;
+	XCTAssertEqual(element.GetParameters(unknown), kAudioUnitErr_InvalidParameter);
+
+	// a reader never sees a mix of two transactions when it reports a consistent snapshot
+	for (auto& item : values) {
+		item.mValue = 0.f;
+	}
+	element.SetParameters(values);
+	std::atomic<bool> done{ false };
+	std::thread writer([&] {
+		auto written = values;
+		for (int i = 0; i < 10000; ++i) {
+			for (auto& item : written) {
+				item.mValue = static_cast<float>(i);
+			}
+			element.SetParameters(written);
+		}
+		done = true;
+	});
+	bool consistent = true;
+	auto snapshot = values;
+	const auto isUniform = [&] {
+		return std::ranges::all_of(snapshot, [&](const ausdk::AUParameterIDValue& item) {
+			return item.mValue == snapshot.front().mValue;
+		});
+	};
+	while (!done) {
+		const OSStatus result = element.GetParameters(snapshot);
+		if (result == noErr) {
+			consistent = consistent && isUniform();
+		} else {
+			consistent = consistent && result == kAudioUnitErr_CannotDoInCurrentContext;
+		}
+	}
+	writer.join();
+	XCTAssertTrue(consistent);
+	XCTAssertEqual(element.GetParameters(snapshot), noErr);
+	XCTAssertEqual(snapshot.front().mValue, 9999.f);
+}
+
+- (void)testParameterTransactionProperty
+{
+	const auto effect = MakeStateTestEffect();
+	UInt32 size = 0;
+	bool writable = false;
+	XCTAssertEqual(effect->DispatchGetPropertyInfo(ausdk::kAUSDKProperty_ParameterTransaction,
+					   kAudioUnitScope_Global, 0, size, writable),
+		noErr);
+	XCTAssertEqual(size, sizeof(ausdk::AUParameterIDValue));
+	XCTAssertTrue(writable);
+
+	const auto set = [&](std::span<const ausdk::AUParameterIDValue> values, UInt32 dataSize) {
+		return effect->DispatchSetProperty(ausdk::kAUSDKProperty_ParameterTransaction,
+			kAudioUnitScope_Global, 0, values.data(), dataSize);
+	};
+	const std::array<ausdk::AUParameterIDValue, 2> values{ { { 3, -1.f }, { 6, -2.f } } };
+	XCTAssertEqual(set(values, sizeof(values)), noErr);
+	XCTAssertEqual(effect->Globals()->GetParameter(3), -1.f);
+	XCTAssertEqual(effect->Globals()->GetParameter(6), -2.f);
+
+	// a partial entry is rejected
+	XCTAssertEqual(set(values, sizeof(values) - 1), kAudioUnitErr_InvalidPropertyValue);
+
+	// once initialized, an unknown ID rejects the whole transaction
+	XCTAssertEqual(effect->DoInitialize(), noErr);
+	const std::array<ausdk::AUParameterIDValue, 2> partlyUnknown{ { { 3, 5.f }, { 1, 5.f } } };
+	XCTAssertThrows(set(partlyUnknown, sizeof(partlyUnknown))); // the dispatcher's status
+	XCTAssertEqual(effect->Globals()->GetParameter(3), -1.f);
+	XCTAssertFalse(effect->Globals()->HasParameterID(1));
+}
+
+// Reports every global parameter at twice its stored value.
+class ScaledParameterEffect : public ausdk::AUEffectBase {
+public:
+	ScaledParameterEffect() : AUEffectBase{ nullptr } {}
+
+	OSStatus GetParameter(AudioUnitParameterID inID, AudioUnitScope inScope,
+		AudioUnitElement inElement, AudioUnitParameterValue& outValue) override
+	{
+		AUSDK_Require_noerr(AUEffectBase::GetParameter(inID, inScope, inElement, outValue));
+		if (inScope == kAudioUnitScope_Global) {
+			outValue *= 2.f;
+		}
+		return noErr;
+	}
+
+	OSStatus GetParameters(AudioUnitScope inScope, AudioUnitElement inElement,
+		std::span<ausdk::AUParameterIDValue> ioValues) override
+	{
+		++mReadRuns;
+		return AUEffectBase::GetParameters(inScope, inElement, ioValues);
+	}
+
+	int mReadRuns = 0;
+};
+
+- (void)testParameterValuesProperties
+{
+	ScaledParameterEffect effect;
+	effect.DoPostConstructor();
+	for (const auto id : { 0u, 1u }) {
+		effect.Globals()->SetParameter(id, 0.f);
+		effect.Input(0).SetParameter(id, 0.f);
+	}
+	XCTAssertEqual(effect.DoInitialize(), noErr);
+
+	UInt32 size = 0;
+	bool writable = false;
+	XCTAssertEqual(effect.DispatchGetPropertyInfo(ausdk::kAUSDKProperty_SetParameterValues,
+					   kAudioUnitScope_Global, 0, size, writable),
+		noErr);
+	XCTAssertEqual(size, sizeof(ausdk::AUParameterAddressValue));
+	XCTAssertTrue(writable);
+	XCTAssertEqual(effect.DispatchGetPropertyInfo(ausdk::kAUSDKProperty_GetParameterValues,
+					   kAudioUnitScope_Global, 0, size, writable),
+		noErr);
+	XCTAssertEqual(size, sizeof(ausdk::AUParameterValueList));
+	XCTAssertEqual(effect.DispatchGetPropertyInfo(ausdk::kAUSDKProperty_SetParameterValues,
+					   kAudioUnitScope_Input, 0, size, writable),
+		kAudioUnitErr_InvalidScope);
+
+	// entries for several elements, in runs which are not contiguous
+	const std::array<ausdk::AUParameterAddressValue, 4> values{ {
+		{ kAudioUnitScope_Global, 0, 0, 1.f },
+		{ kAudioUnitScope_Input, 0, 1, 2.f },
+		{ kAudioUnitScope_Input, 0, 0, 3.f },
+		{ kAudioUnitScope_Global, 0, 1, 4.f },
+	} };
+	XCTAssertEqual(effect.DispatchSetProperty(ausdk::kAUSDKProperty_SetParameterValues,
+					   kAudioUnitScope_Global, 0, values.data(), sizeof(values)),
+		noErr);
+	XCTAssertEqual(effect.Globals()->GetParameter(0), 1.f);
+	XCTAssertEqual(effect.Globals()->GetParameter(1), 4.f);
+	XCTAssertEqual(effect.Input(0).GetParameter(0), 3.f);
+	XCTAssertEqual(effect.Input(0).GetParameter(1), 2.f);
+	XCTAssertEqual(effect.DispatchSetProperty(ausdk::kAUSDKProperty_SetParameterValues,
+					   kAudioUnitScope_Global, 0, values.data(), sizeof(values) - 1),
+		kAudioUnitErr_InvalidPropertyValue);
+
+	// reads go through the virtual GetParameter, one GetParameters call per run
+	auto readBack = values;
+	for (auto& value : readBack) {
+		value.mValue = 0.f;
+	}
+	ausdk::AUParameterValueList list{ readBack.data(), static_cast<UInt32>(readBack.size()) };
+	XCTAssertEqual(effect.DispatchGetProperty(
+					   ausdk::kAUSDKProperty_GetParameterValues, kAudioUnitScope_Global, 0, &list),
+		noErr);
+	XCTAssertEqual(readBack[0].mValue, 2.f);
+	XCTAssertEqual(readBack[1].mValue, 2.f);
+	XCTAssertEqual(readBack[2].mValue, 3.f);
+	XCTAssertEqual(readBack[3].mValue, 8.f);
+	XCTAssertEqual(effect.mReadRuns, 3);
+
+	list = { nullptr, 0 };
+	XCTAssertEqual(effect.DispatchGetProperty(
+					   ausdk::kAUSDKProperty_GetParameterValues, kAudioUnitScope_Global, 0, &list),
+		noErr);
+	list = { nullptr, 1 };
+	XCTAssertEqual(effect.DispatchGetProperty(
+					   ausdk::kAUSDKProperty_GetParameterValues, kAudioUnitScope_Global, 0, &list),
+		kAudio_ParamError);
+}
+
+- (void)testClassInfoStateBounds
+{
+	const auto source = MakeStateTestEffect();
+	const auto destination = MakeStateTestEffect();
+	CFPropertyListRef state = nullptr;
+	XCTAssertEqual(source->SaveState(&state), noErr);
+	auto* const dict = static_cast<CFMutableDictionaryRef>(const_cast<void*>(state)); // NOLINT
+	const auto data = ausdk::Owned<CFDataRef>::from_get(
+		static_cast<CFDataRef>(CFDictionaryGetValue(dict, CFSTR(kAUPresetDataKey))));
+	const auto restoreError = [&]() -> OSStatus {
+		try {
+			return destination->RestoreState(state);
+		} catch (const ausdk::AUException& e) {
+			return e.mError;
+		}
+	};
+
+	// a parameter count larger than the data is rejected before it sizes anything
+	const auto oversized =
+		ausdk::Owned<CFMutableDataRef>::from_create(CFDataCreateMutableCopy(nullptr, 0, *data));
+	const UInt32 hugeCount = CFSwapInt32HostToBig(0xFFFFFFFFu);
+	std::memcpy(CFDataGetMutableBytePtr(*oversized) + 8, &hugeCount, sizeof(hugeCount));
+	CFDictionarySetValue(dict, CFSTR(kAUPresetDataKey), *oversized);
+	XCTAssertEqual(restoreError(), kAudioUnitErr_InvalidPropertyValue);
+
+	// as is data which ends part way through a parameter or a header
+	for (const CFIndex cut : { 3, 10 }) {
+		const auto truncated = ausdk::Owned<CFMutableDataRef>::from_create(
+			CFDataCreateMutableCopy(nullptr, 0, *data));
+		CFDataSetLength(*truncated, CFDataGetLength(*data) - cut);
+		CFDictionarySetValue(dict, CFSTR(kAUPresetDataKey), *truncated);
+		XCTAssertEqual(restoreError(), kAudioUnitErr_InvalidPropertyValue);
+	}
+	CFRelease(state);
+}
+
+// Counts GetParameterInfo calls, and reports a released name and a settable default for each
+// global parameter.
+class ParameterInfoTestEffect : public ausdk::AUEffectBase {
+public:
+	ParameterInfoTestEffect() : AUEffectBase{ nullptr } {}
+
+	OSStatus GetParameterInfo(AudioUnitScope inScope, AudioUnitParameterID /*inParameterID*/,
+		AudioUnitParameterInfo& outParameterInfo) override
+	{
+		mInfoCalls.fetch_add(1);
+		if (inScope != kAudioUnitScope_Global) {
+			return kAudioUnitErr_InvalidParameter;
+		}
+		outParameterInfo.flags =
+			kAudioUnitParameterFlag_IsReadable | kAudioUnitParameterFlag_IsWritable;
+		outParameterInfo.maxValue = 100.f;
+		outParameterInfo.defaultValue = mDefaultValue.load();
+		FillInParameterName(outParameterInfo,
+			CFStringCreateWithCString(nullptr, "Gain", kCFStringEncodingUTF8), true);
+		return noErr;
+	}
+
+	std::atomic<int> mInfoCalls{ 0 };
+	std::atomic<float> mDefaultValue{ 1.f };
+};
+
+// Queries the info of global parameter 2 as a host would, releasing the copied name, and returns
+// its default value, or NaN on failure.
+static float QueryDefaultValue(ausdk::AUBase& unit)
+{
+	AudioUnitParameterInfo info{};
+	if (unit.DispatchGetProperty(
+			kAudioUnitProperty_ParameterInfo, kAudioUnitScope_Global, 2, &info) != noErr ||
+		(info.flags & kAudioUnitParameterFlag_CFNameRelease) == 0u) {
+		return std::numeric_limits<float>::quiet_NaN();
+	}
+	CFRelease(info.cfNameString);
+	return info.defaultValue;
+}
+
+- (void)testParameterMetadataCache
+{
+	ParameterInfoTestEffect effect;
+	effect.DoPostConstructor();
+	for (AudioUnitParameterID id = 0; id < 4; ++id) {
+		effect.Globals()->SetParameter(id, 0.f);
+	}
+
+	// nothing is cached before Initialize
+	XCTAssertFalse(std::isnan(QueryDefaultValue(effect)));
+	XCTAssertFalse(std::isnan(QueryDefaultValue(effect)));
+	XCTAssertEqual(effect.mInfoCalls.load(), 2);
+
+	// the first query after Initialize caches the whole element, and later ones are served from it
+	XCTAssertEqual(effect.DoInitialize(), noErr);
+	effect.mInfoCalls = 0;
+	XCTAssertEqual(QueryDefaultValue(effect), 1.f);
+	XCTAssertEqual(effect.mInfoCalls.load(), 4);
+	XCTAssertFalse(std::isnan(QueryDefaultValue(effect)));
+	CFPropertyListRef state = nullptr;
+	XCTAssertEqual(effect.SaveState(&state), noErr);
+	CFRelease(state);
+	XCTAssertEqual(effect.mInfoCalls.load(), 4);
+
+	// a ParameterInfo change rebuilds it on next use
+	effect.mDefaultValue = 2.f;
+	effect.PropertyChanged(kAudioUnitProperty_ParameterInfo, kAudioUnitScope_Global, 0);
+	XCTAssertEqual(effect.mInfoCalls.load(), 4);
+	XCTAssertEqual(QueryDefaultValue(effect), 2.f);
+	XCTAssertEqual(effect.mInfoCalls.load(), 8);
+
+	// as does redefining the parameters
+	effect.Globals()->SetParameter(9, 0.f, true);
+	XCTAssertFalse(std::isnan(QueryDefaultValue(effect)));
+	XCTAssertEqual(effect.mInfoCalls.load(), 13);
+
+	// and Cleanup drops it
+	effect.DoCleanup();
+	effect.mInfoCalls = 0;
+	XCTAssertFalse(std::isnan(QueryDefaultValue(effect)));
+	XCTAssertFalse(std::isnan(QueryDefaultValue(effect)));
+	XCTAssertEqual(effect.mInfoCalls.load(), 2);
+}
+
+- (void)testParameterMetadataCacheConcurrency
+{
+	ParameterInfoTestEffect effect;
+	effect.DoPostConstructor();
+	for (AudioUnitParameterID id = 0; id < 64; ++id) {
+		effect.Globals()->SetParameter(id, 0.f);
+	}
+	XCTAssertEqual(effect.DoInitialize(), noErr);
+
+	// hosts query and save on their own threads while the unit keeps invalidating the cache
+	std::atomic<bool> done{ false };
+	std::vector<std::thread> readers;
+	for (int i = 0; i < 2; ++i) {
+		readers.emplace_back([&] {
+			while (!done) {
+				const float defaultValue = QueryDefaultValue(effect);
+				XCTAssertTrue(defaultValue == 1.f || defaultValue == 2.f);
+				CFPropertyListRef state = nullptr;
+				XCTAssertEqual(effect.SaveState(&state), noErr);
+				CFRelease(state);
+			}
+		});
+	}
+	for (int i = 0; i < 1000; ++i) {
+		effect.mDefaultValue = (i % 2 == 0) ? 2.f : 1.f;
+		effect.PropertyChanged(kAudioUnitProperty_ParameterInfo, kAudioUnitScope_Global, 0);
+		std::this_thread::yield();
+	}
+	done = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+	XCTAssertEqual(QueryDefaultValue(effect), 1.f);
+}
+
+- (void)testPublishedParametersUnderContention
+{
+	MorphTestEffect effect;
+	effect.DoPostConstructor();
+	for (AudioUnitParameterID paramID = 0; paramID < 3; ++paramID) {
+		effect.Globals()->SetParameter(paramID, 0.f);
+	}
+	effect.SetDefersParameterRestore(true);
+	XCTAssertEqual(effect.DoInitialize(), noErr);
+	XCTAssertThrows(effect.PublishParameterSnapshot(nullptr));
+	XCTAssertThrows(effect.BeginParameterMorph(nullptr, 64));
+
+	// another thread's transactions on the same element never make the render thread wait; the
+	// snapshot is applied on whichever cycle finds the element free
+	std::atomic<bool> done{ false };
+	std::thread writer([&] {
+		const std::array<ausdk::AUParameterIDValue, 1> value{ { { 2, 1.f } } };
+		while (!done) {
+			effect.Globals()->SetParameters(value);
+		}
+	});
+	auto snapshot = std::make_unique<ausdk::AUParameterSnapshot>();
+	const std::array<ausdk::AUParameterIDValue, 2> values{ { { 0, 100.f }, { 1, 200.f } } };
+	snapshot->Add(*effect.Globals(), values);
+	effect.PublishParameterSnapshot(std::move(snapshot));
+	MorphTestEffect::ParameterEventList events;
+	for (int cycle = 0; cycle < 1000 && effect.Globals()->GetParameter(1) != 200.f; ++cycle) {
+		XCTAssertEqual(effect.ProcessForScheduledParams(events, 64, nullptr), noErr);
+		std::this_thread::yield();
+	}
+	done = true;
+	writer.join();
+	XCTAssertEqual(effect.Globals()->GetParameter(0), 100.f);
+	XCTAssertEqual(effect.Globals()->GetParameter(1), 200.f);
+}
+
+- (void)testClassInfoStatePerformance
+{
+	const auto owner = MakeStateTestEffect();
+	auto* const effect = owner.get();
+	[self measureBlock:^{
+		for (int i = 0; i < 100; ++i) {
+			CFPropertyListRef state = nullptr;
+			effect->SaveState(&state);
+			effect->RestoreState(state);
+			CFRelease(state);
+		}
+	}];
+}
+
+- (void)testBinaryStatePerformance
+{
+	const auto owner = MakeStateTestEffect();
+	auto* const effect = owner.get();
+	[self measureBlock:^{
+		for (int i = 0; i < 100; ++i) {
+			CFDataRef state = nullptr;
+			effect->SaveBinaryState(&state);
+			effect->RestoreBinaryState(state);
+			CFRelease(state);
+		}
+	}];
+}
+
+// Pulls all eight inputs of a ParallelPullTestUnit for 100 render cycles.
+static void RunParallelPulls(ParallelPullTestUnit& unit)
+{
+	std::array<AudioUnitElement, ParallelPullTestUnit::kInputCount> elements{};
+	std::iota(elements.begin(), elements.end(), 0);
+	std::array<AudioUnitRenderActionFlags, elements.size()> flags{};
+	std::array<OSStatus, elements.size()> results{};
+	AudioTimeStamp timeStamp{ .mFlags = kAudioTimeStampSampleTimeValid };
+	for (int cycle = 0; cycle < 100; ++cycle) {
+		unit.PullInputs(elements, 0, timeStamp, 512, flags, results);
+		timeStamp.mSampleTime += 512;
+	}
+}
+
+- (void)testParallelPullSerialPerformance
+{
+	const auto owner = MakeParallelPullTestUnit(nullptr);
+	auto* const unit = owner.get();
+	[self measureBlock:^{
+		RunParallelPulls(*unit);
+	}];
+}
+
+- (void)testParallelPullTwoThreadsPerformance
+{
+	const auto owner = MakeParallelPullTestUnit(nullptr);
+	auto* const unit = owner.get();
+	unit->SetParallelPullThreadCount(2);
+	[self measureBlock:^{
+		RunParallelPulls(*unit);
+	}];
+}
+
+- (void)testParallelPullSevenThreadsPerformance
+{
+	const auto owner = MakeParallelPullTestUnit(nullptr);
+	auto* const unit = owner.get();
+	unit->SetParallelPullThreadCount(7);
+	[self measureBlock:^{
+		RunParallelPulls(*unit);
+	}];
+}
+
 @end